@@ -546,9 +546,9 @@ void mmAssetsPanel::sortTable()
         break;
     case COL_VALUE_CURRENT:
         std::stable_sort(this->m_assets.begin(), this->m_assets.end()
-            , [](const Model_Asset::Data& x, const Model_Asset::Data& y)
+            , [this](const Model_Asset::Data& x, const Model_Asset::Data& y)
             {
-                return Model_Asset::value(x) < Model_Asset::value(y);
+                return m_asset_values[x.ASSETID] < m_asset_values[y.ASSETID];
             });
         break;
     case COL_DATE:
@@ -576,12 +576,13 @@ int mmAssetsPanel::initVirtualListControl(int id, int col, bool asc)
         this->m_assets = Model_Asset::instance().all();
     else
         this->m_assets = Model_Asset::instance().find(Model_Asset::ASSETTYPE(m_filter_type));
+    this->m_asset_values = Model_Asset::instance().valueAtDate(this->m_assets, wxDate::Today());
     this->sortTable();
 
     m_listCtrlAssets->SetItemCount(this->m_assets.size());
 
     double balance = 0.0;
-    for (const auto& asset: this->m_assets) balance += Model_Asset::value(asset); 
+    for (const auto& item : this->m_asset_values) balance += item.second;
     header_text_->SetLabelText(wxString::Format(_("Total: %s"), Model_Currency::toCurrency(balance))); // balance
 
     int selected_item = 0;
@@ -639,7 +640,7 @@ wxString mmAssetsPanel::getItem(long item, long column)
     case COL_VALUE_INITIAL:
         return Model_Currency::toCurrency(asset.VALUE);
     case COL_VALUE_CURRENT:
-        return Model_Currency::toCurrency(Model_Asset::value(asset));
+        return Model_Currency::toCurrency(m_asset_values[asset.ASSETID]);
     case COL_DATE:
         return mmGetDateForDisplay(asset.STARTDATE);
     case COL_NOTES:
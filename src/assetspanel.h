@@ -101,6 +101,7 @@ public:
     wxString getItem(long item, long column);
 
     Model_Asset::Data_Set m_assets;
+    std::map<int, double> m_asset_values;
     Model_Asset::TYPE m_filter_type;
     int col_max() { return COL_MAX; }
     int col_sort() { return COL_DATE; }
@@ -27,7 +27,12 @@
 #include "model/Model_Attachment.h"
 #include "model/Model_Infotable.h"
 
+#include <wx/ffile.h>
 #include <wx/mimetype.h>
+#include <wx/regex.h>
+#include <cstring>
+#include <set>
+#include <vector>
 
 wxIMPLEMENT_DYNAMIC_CLASS(mmAttachmentDialog, wxDialog);
 
@@ -197,7 +202,6 @@ void mmAttachmentDialog::AddAttachment(wxString FilePath)
     }
 
     const wxString attachmentFileName = wxFileName(FilePath).GetName();
-    const wxString attachmentFileExtension = wxFileName(FilePath).GetExt().MakeLower();
     
     mmDialogComboBoxAutocomplete dlg(this, _("Enter a description for the new attachment:") + wxString::Format("\n(%s)", FilePath),
         _("Organize Attachments: Add Attachment"), attachmentFileName, Model_Attachment::instance().allDescriptions());
@@ -207,15 +211,8 @@ void mmAttachmentDialog::AddAttachment(wxString FilePath)
 
     const wxString attachmentDescription = dlg.getText();
 
-    const wxString attachmentsFolder = mmex::getPathAttachment(mmAttachmentManage::InfotablePathSetting());
-    int attachmentLastNumber = Model_Attachment::LastAttachmentNumber(m_RefType, m_RefId);
-
-    wxString importedFileName = m_RefType + "_" + wxString::Format("%i", m_RefId) + "_Attach"
-        + wxString::Format("%i", attachmentLastNumber + 1);
-    if (!attachmentFileExtension.empty())
-        importedFileName += "." + attachmentFileExtension;
-
-    if (mmAttachmentManage::CopyAttachment(FilePath, attachmentsFolder + m_RefType + m_PathSep + importedFileName))
+    const wxString importedFileName = mmAttachmentManage::ImportAttachment(FilePath, m_RefType);
+    if (!importedFileName.empty())
     {
         Model_Attachment::Data* NewAttachment = Model_Attachment::instance().create();
         NewAttachment->REFTYPE = m_RefType;
@@ -274,7 +271,9 @@ void mmAttachmentDialog::DeleteAttachment()
         if (DeleteResponse == wxYES)
         {
             const wxString AttachmentsFolder = mmex::getPathAttachment(mmAttachmentManage::InfotablePathSetting()) + attachment->REFTYPE;
-            if (mmAttachmentManage::DeleteAttachment(AttachmentsFolder + m_PathSep + attachment->FILENAME))
+            // the stored file stays while other attachments share it
+            if (Model_Attachment::RefCount(attachment->REFTYPE, attachment->FILENAME) > 1
+                || mmAttachmentManage::DeleteAttachment(AttachmentsFolder + m_PathSep + attachment->FILENAME))
             {
                 Model_Attachment::instance().remove(m_attachment_id);
             }
@@ -471,6 +470,90 @@ bool mmAttachmentManage::CopyAttachment(const wxString& FileToImport, const wxSt
     return true;
 }
 
+/** Return a 64-bit FNV-1a hash of the file content as 16 hex digits, empty if the file can't be read */
+wxString mmAttachmentManage::ContentHash(const wxString& FilePath)
+{
+    wxFFile file(FilePath, "rb");
+    if (!file.IsOpened()) return wxEmptyString;
+
+    wxUint64 hash = wxULL(14695981039346656037);
+    char buffer[65536];
+    size_t read;
+    while ((read = file.Read(buffer, sizeof(buffer))) > 0)
+    {
+        for (size_t i = 0; i < read; i++)
+        {
+            hash ^= static_cast<unsigned char>(buffer[i]);
+            hash *= wxULL(1099511628211);
+        }
+    }
+    if (file.Error()) return wxEmptyString;
+
+    return wxString::Format("%016" wxLongLongFmtSpec "x", hash);
+}
+
+/** Return true when both files can be read and hold the same bytes */
+bool mmAttachmentManage::SameContent(const wxString& FilePath, const wxString& OtherPath)
+{
+    wxFFile file(FilePath, "rb"), other(OtherPath, "rb");
+    if (!file.IsOpened() || !other.IsOpened() || file.Length() != other.Length())
+        return false;
+
+    std::vector<char> buffer(65536), other_buffer(65536);
+    size_t read;
+    while ((read = file.Read(buffer.data(), buffer.size())) > 0)
+    {
+        if (other.Read(other_buffer.data(), read) != read
+            || memcmp(buffer.data(), other_buffer.data(), read) != 0)
+            return false;
+    }
+    return !file.Error() && !other.Error();
+}
+
+/**
+Store the file in the RefType folder under a name derived from its content.
+Identical files are stored once and shared by all their attachments,
+so importing the same receipt again copies nothing.
+The hash only picks the name: a stored file is reused when its bytes match,
+a different file with the same hash is stored under the next free suffix.
+* Return the stored file name, empty on failure
+*/
+wxString mmAttachmentManage::StoreAttachment(const wxString& FileToStore, const wxString& RefType)
+{
+    const wxString hash = mmAttachmentManage::ContentHash(FileToStore);
+    if (hash.empty()) return wxEmptyString;
+
+    const wxString extension = wxFileName(FileToStore).GetExt().MakeLower();
+    const wxString destinationFolder = mmex::getPathAttachment(mmAttachmentManage::InfotablePathSetting()) + RefType;
+    if (!wxDirExists(destinationFolder))
+    {
+        if (wxMkdir(destinationFolder))
+            mmAttachmentManage::CreateReadmeFile(destinationFolder);
+        else
+            return wxEmptyString;
+    }
+
+    for (int suffix = 0; ; suffix++)
+    {
+        const wxString FileName = RefType + "_" + hash + (suffix ? wxString::Format("_%i", suffix) : "")
+            + (extension.empty() ? "" : "." + extension);
+        const wxString StoredFile = destinationFolder + m_PathSep + FileName;
+
+        if (!wxFileExists(StoredFile))
+            return wxCopyFile(FileToStore, StoredFile, false) ? FileName : wxString();
+        if (mmAttachmentManage::SameContent(FileToStore, StoredFile))
+            return FileName;
+    }
+}
+
+wxString mmAttachmentManage::ImportAttachment(const wxString& FileToImport, const wxString& RefType)
+{
+    const wxString FileName = mmAttachmentManage::StoreAttachment(FileToImport, RefType);
+    if (!FileName.empty() && Model_Infotable::instance().GetBoolInfo("ATTACHMENTSDELETE", false))
+        wxRemoveFile(FileToImport);
+    return FileName;
+}
+
 bool mmAttachmentManage::DeleteAttachment(const wxString& FileToDelete)
 {
     if (wxFileExists(FileToDelete))
@@ -533,44 +616,77 @@ bool mmAttachmentManage::DeleteAllAttachments(const wxString& RefType, int RefId
 
     for (const auto &entry : attachments)
     {
-        mmAttachmentManage::DeleteAttachment(AttachmentsFolder + m_PathSep + entry.FILENAME);
+        if (Model_Attachment::RefCount(entry.REFTYPE, entry.FILENAME) < 2)
+            mmAttachmentManage::DeleteAttachment(AttachmentsFolder + m_PathSep + entry.FILENAME);
         Model_Attachment::instance().remove(entry.ATTACHMENTID);
     }
     return true;
 }
 
+bool mmAttachmentManage::DeleteAllAttachments(const wxString& RefType, const std::vector<int>& RefIds)
+{
+    const wxString AttachmentsFolder = mmex::getPathAttachment(mmAttachmentManage::InfotablePathSetting()) + m_PathSep + RefType;
+    const wxString reftype_where = wxString::Format("REFTYPE = '%s'", RefType);
+
+    // a stored file is deleted with the last attachment sharing it,
+    // once the records are gone so a failing delete keeps the files
+    std::set<wxString> files;
+    for (const auto& entry : Model_Attachment::instance().find_in(Model_Attachment::REFID::name(), RefIds))
+    {
+        if (entry.REFTYPE == RefType)
+            files.insert(entry.FILENAME);
+    }
+    Model_Attachment::instance().remove_in(Model_Attachment::REFID::name(), RefIds, reftype_where);
+    for (const auto& file : files)
+    {
+        if (Model_Attachment::RefCount(RefType, file) == 0)
+            mmAttachmentManage::DeleteAttachment(AttachmentsFolder + m_PathSep + file);
+    }
+    return true;
+}
+
 bool mmAttachmentManage::RelocateAllAttachments(const wxString& RefType, int OldRefId, int NewRefId)
 {
     auto attachments = Model_Attachment::instance().find(Model_Attachment::DB_Table_ATTACHMENT_V1::REFTYPE(RefType), Model_Attachment::REFID(OldRefId));
     const wxString AttachmentsFolder = mmex::getPathAttachment(mmAttachmentManage::InfotablePathSetting()) + RefType + m_PathSep;
 
+    // Files named RefType_RefId_AttachN by earlier versions and the WebApp download
+    // would be overwritten once their id is reused, so they move to a content name.
+    // Content named files may be shared with other attachments and keep their names.
+    wxRegEx legacy_name("^" + RefType + "_-?[0-9]+_Attach[0-9]+");
+    std::set<wxString> legacy_files;
     for (auto &entry : attachments)
     {
-        wxString NewFileName = entry.FILENAME;
-        NewFileName.Replace(entry.REFTYPE + "_" + wxString::Format("%i", entry.REFID), entry.REFTYPE + "_" + wxString::Format("%i", NewRefId));
-        wxRenameFile(AttachmentsFolder + entry.FILENAME, AttachmentsFolder + NewFileName);
         entry.REFID = NewRefId;
-        entry.FILENAME = NewFileName;
+        if (!legacy_name.Matches(entry.FILENAME)) continue;
+
+        const wxString FileName = mmAttachmentManage::StoreAttachment(AttachmentsFolder + entry.FILENAME, RefType);
+        if (FileName.empty()) continue;
+        legacy_files.insert(entry.FILENAME);
+        entry.FILENAME = FileName;
     }
     Model_Attachment::instance().save(attachments);
 
+    for (const auto& file : legacy_files)
+    {
+        if (Model_Attachment::RefCount(RefType, file) == 0)
+            wxRemoveFile(AttachmentsFolder + file);
+    }
+
     return true;
 }
 
 bool mmAttachmentManage::CloneAllAttachments(const wxString& RefType, int OldRefId, int NewRefId)
 {
     auto attachments = Model_Attachment::instance().find(Model_Attachment::DB_Table_ATTACHMENT_V1::REFTYPE(RefType), Model_Attachment::REFID(OldRefId));
-    const wxString AttachmentsFolder = mmex::getPathAttachment(mmAttachmentManage::InfotablePathSetting()) + RefType + m_PathSep;
 
+    // the clones share the stored files, nothing is copied
     for (auto &entry : attachments)
     {
-        wxString NewFileName = entry.FILENAME;
-        NewFileName.Replace(entry.REFTYPE + "_" + wxString::Format("%i", entry.REFID), entry.REFTYPE + "_" + wxString::Format("%i", NewRefId));
-        wxCopyFile(AttachmentsFolder + entry.FILENAME, AttachmentsFolder + NewFileName);
         Model_Attachment::Data* NewAttachment = Model_Attachment::instance().create();
         NewAttachment->REFTYPE = RefType;
         NewAttachment->REFID = NewRefId;
-        NewAttachment->FILENAME = NewFileName;
+        NewAttachment->FILENAME = entry.FILENAME;
         NewAttachment->DESCRIPTION = entry.DESCRIPTION;
         Model_Attachment::instance().save(NewAttachment);
     }
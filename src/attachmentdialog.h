@@ -23,6 +23,7 @@
 #include "defs.h"
 #include <wx/dataview.h>
 #include <map>
+#include <vector>
 
 class mmAttachmentDialog : public wxDialog
 {
@@ -89,13 +90,18 @@ public:
     static const wxString GetAttachmentNoteSign();
     static bool CreateReadmeFile(const wxString& FolderPath);
     static bool CopyAttachment(const wxString& FileToImport, const wxString& ImportedFile);
+    static wxString ContentHash(const wxString& FilePath);
+    static bool SameContent(const wxString& FilePath, const wxString& OtherPath);
+    static wxString ImportAttachment(const wxString& FileToImport, const wxString& RefType);
     static bool DeleteAttachment(const wxString& FileToDelete);
     static bool OpenAttachment(const wxString& FileToOpen);
     static bool DeleteAllAttachments(const wxString& RefType, int RefId);
+    static bool DeleteAllAttachments(const wxString& RefType, const std::vector<int>& RefIds);
     static bool RelocateAllAttachments(const wxString& RefType, int OldRefId, int NewRefId);
     static bool CloneAllAttachments(const wxString& RefType, int OldRefId, int NewRefId);
     static void OpenAttachmentFromPanelIcon(wxWindow* parent, const wxString& RefType, int RefId);
 private:
+    static wxString StoreAttachment(const wxString& FileToStore, const wxString& RefType);
     static wxString m_PathSep;
 };
 
@@ -0,0 +1,256 @@
+/*******************************************************
+ Copyright (C) 2026 MoneyManagerEx contributors
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "autocomplete.h"
+#include "singleton.h"
+#include "util.h"
+#include "model/Model_Account.h"
+#include "model/Model_Category.h"
+#include "model/Model_Checking.h"
+#include "model/Model_Payee.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <tuple>
+
+mmAutoComplete& mmAutoComplete::instance()
+{
+    return Singleton<mmAutoComplete>::instance();
+}
+
+void mmAutoComplete::Reset()
+{
+    for (int kind = 0; kind < KIND_MAX; kind++)
+    {
+        m_names_loaded[kind] = false;
+        m_names[kind].clear();
+        m_prefix[kind].clear();
+        m_uses[kind].clear();
+    }
+    m_trans_loaded = false;
+    m_trans.clear();
+    m_notes.clear();
+    m_top_notes.clear();
+    m_pending_trans.clear();
+}
+
+void mmAutoComplete::OnRowChanged(const wxString& table, long long rowid, bool deleted)
+{
+    if (table == "CHECKINGACCOUNT_V1")
+    {
+        if (m_trans_loaded)
+            m_pending_trans.insert(deleted ? -static_cast<int>(rowid) : static_cast<int>(rowid));
+    }
+    else if (table == "PAYEE_V1")
+        m_names_loaded[PAYEE] = false;
+    else if (table == "ACCOUNTLIST_V1")
+        m_names_loaded[ACCOUNT] = false;
+    // full category names depend on CATEG_DELIMITER
+    else if (table == "CATEGORY_V1" || table == "INFOTABLE_V1")
+        m_names_loaded[CATEGORY] = false;
+}
+
+void mmAutoComplete::Sync()
+{
+    for (int pending : m_pending_trans)
+    {
+        const int id = std::abs(pending);
+        RemoveTrans(id);
+        if (pending < 0) continue;
+
+        const Model_Checking::Data* t = Model_Checking::instance().get(id);
+        if (t && t->TRANSID == id)
+            AddTrans(id, { t->ACCOUNTID, t->PAYEEID, t->NOTES, t->TRANSDATE, t->CATEGID });
+    }
+    m_pending_trans.clear();
+}
+
+void mmAutoComplete::LoadTransactions()
+{
+    m_trans.clear();
+    m_notes.clear();
+    m_top_notes.clear();
+    for (int kind = 0; kind < KIND_MAX; kind++)
+        m_uses[kind].clear();
+
+    const auto trans = Model_Checking::instance().all_view();
+    for (const auto& t : trans.rows())
+        AddTrans(t.TRANSID, { t.ACCOUNTID, t.PAYEEID, trans.str(t.NOTES), trans.str(t.TRANSDATE), t.CATEGID });
+    m_pending_trans.clear();
+    m_trans_loaded = true;
+}
+
+void mmAutoComplete::AddTrans(int id, const Trans& t)
+{
+    m_trans[id] = t;
+    m_uses[ACCOUNT][t.account]++;
+    m_uses[PAYEE][t.payee]++;
+    m_uses[CATEGORY][t.category]++;
+
+    if (t.notes.empty()) return;
+    for (int key : { t.account, -1 })
+    {
+        NoteStat& stat = m_notes[key][t.notes];
+        stat.count++;
+        if (t.date > stat.last) stat.last = t.date;
+        m_top_notes.erase(key);
+    }
+}
+
+void mmAutoComplete::RemoveTrans(int id)
+{
+    auto it = m_trans.find(id);
+    if (it == m_trans.end()) return;
+    const Trans& t = it->second;
+
+    m_uses[ACCOUNT][t.account]--;
+    m_uses[PAYEE][t.payee]--;
+    m_uses[CATEGORY][t.category]--;
+
+    if (!t.notes.empty())
+    {
+        // the last date of a note is not rolled back, it only breaks ties
+        for (int key : { t.account, -1 })
+        {
+            auto& notes = m_notes[key];
+            auto stat = notes.find(t.notes);
+            if (stat != notes.end() && --stat->second.count <= 0)
+                notes.erase(stat);
+            m_top_notes.erase(key);
+        }
+    }
+    m_trans.erase(it);
+}
+
+void mmAutoComplete::LoadNames(KIND kind)
+{
+    auto& names = m_names[kind];
+    names.clear();
+
+    switch (kind)
+    {
+    case PAYEE:
+        for (const auto& payee : Model_Payee::instance().all())
+            names.push_back({ payee.PAYEENAME, payee.PAYEENAME.Lower(), payee.PAYEEID, payee.ACTIVE == 1 });
+        break;
+    case ACCOUNT:
+        for (const auto& account : Model_Account::instance().all())
+        {
+            if (Model_Account::type(account) == Model_Account::INVESTMENT || account.ACCOUNTNAME.empty())
+                continue;
+            names.push_back({ account.ACCOUNTNAME, account.ACCOUNTNAME.Lower(), account.ACCOUNTID
+                , Model_Account::status(account) != Model_Account::CLOSED });
+        }
+        break;
+    case CATEGORY:
+        for (const auto& category : Model_Category::instance().all())
+        {
+            const wxString name = Model_Category::full_name(category.CATEGID);
+            names.push_back({ name, name.Lower(), category.CATEGID, category.ACTIVE != 0 });
+        }
+        break;
+    default:
+        break;
+    }
+
+    // sorted once here instead of by every combo box on focus
+    std::sort(names.begin(), names.end(), [](const Entry& a, const Entry& b)
+        { return CaseInsensitiveLocaleCmp(a.name, b.name) < 0; });
+
+    auto& prefix = m_prefix[kind];
+    prefix.resize(names.size());
+    for (size_t i = 0; i < names.size(); i++) prefix[i] = i;
+    std::sort(prefix.begin(), prefix.end(), [&names](size_t a, size_t b)
+        { return names[a].lower < names[b].lower; });
+
+    m_names_loaded[kind] = true;
+}
+
+void mmAutoComplete::Fill(KIND kind, bool activeOnly, std::map<wxString, int>& names, wxArrayString& sorted)
+{
+    if (!m_names_loaded[kind]) LoadNames(kind);
+
+    names.clear();
+    sorted.Clear();
+    sorted.Alloc(m_names[kind].size());
+    for (const auto& entry : m_names[kind])
+    {
+        if (activeOnly && !entry.active) continue;
+        names[entry.name] = entry.id;
+        sorted.Add(entry.name);
+    }
+}
+
+wxArrayString mmAutoComplete::Complete(KIND kind, const wxString& prefix, const std::map<wxString, int>& allowed, size_t max)
+{
+    if (!m_names_loaded[kind]) LoadNames(kind);
+    if (!m_trans_loaded) LoadTransactions();
+    Sync();
+
+    const auto& names = m_names[kind];
+    const auto& order = m_prefix[kind];
+    const wxString lower = prefix.Lower();
+
+    auto it = std::lower_bound(order.begin(), order.end(), lower
+        , [&names](size_t i, const wxString& value) { return names[i].lower < value; });
+
+    std::vector<size_t> matches;
+    for (; it != order.end() && names[*it].lower.StartsWith(lower); ++it)
+    {
+        if (allowed.count(names[*it].name))
+            matches.push_back(*it);
+    }
+
+    auto& uses = m_uses[kind];
+    std::stable_sort(matches.begin(), matches.end(), [&](size_t a, size_t b)
+        { return uses[names[a].id] > uses[names[b].id]; });
+
+    wxArrayString result;
+    for (size_t i = 0; i < matches.size() && i < max; i++)
+        result.Add(names[matches[i]].name);
+    return result;
+}
+
+void mmAutoComplete::FrequentNotes(std::vector<wxString>& notes, int accountID)
+{
+    const size_t max = 20;
+    if (!m_trans_loaded) LoadTransactions();
+    Sync();
+
+    const int key = accountID > 0 ? accountID : -1;
+    auto cached = m_top_notes.find(key);
+    if (cached == m_top_notes.end())
+    {
+        // Sort by frequency then date
+        std::vector<std::tuple<int, wxString, wxString>> vec;
+        for (const auto& entry : m_notes[key])
+            vec.emplace_back(entry.second.count, entry.second.last, entry.first);
+        std::sort(vec.begin(), vec.end(), [](const std::tuple<int, wxString, wxString>& a
+            , const std::tuple<int, wxString, wxString>& b)
+        {
+            if (std::get<0>(a) != std::get<0>(b)) return std::get<0>(a) > std::get<0>(b);
+            return std::get<1>(a) > std::get<1>(b);
+        });
+
+        std::vector<wxString> top;
+        for (size_t i = 0; i < vec.size() && i < max; i++)
+            top.push_back(std::get<2>(vec[i]));
+        cached = m_top_notes.emplace(key, top).first;
+    }
+    notes = cached->second;
+}
@@ -0,0 +1,94 @@
+/*******************************************************
+ Copyright (C) 2026 MoneyManagerEx contributors
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#ifndef MM_EX_AUTOCOMPLETE_H_
+#define MM_EX_AUTOCOMPLETE_H_
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include <wx/arrstr.h>
+
+/*
+    Completion data shared by every combo box and transaction dialog.
+    Built once from the models, then kept current from the SQLite update
+    hook: the hook only queues table/rowid pairs, they are applied on the
+    next lookup so no model is read while a statement is still stepping.
+*/
+class mmAutoComplete
+{
+public:
+    enum KIND { PAYEE = 0, ACCOUNT, CATEGORY, KIND_MAX };
+
+    static mmAutoComplete& instance();
+
+    /* Forget everything, the next lookup reloads from the open database */
+    void Reset();
+    /* Called from UpdateCallbackHook for every row written */
+    void OnRowChanged(const wxString& table, long long rowid, bool deleted);
+
+    /* Name -> id for the combo boxes plus the same names already sorted for display */
+    void Fill(KIND kind, bool activeOnly, std::map<wxString, int>& names, wxArrayString& sorted);
+    /* Names in allowed starting with prefix (case insensitive), most used first */
+    wxArrayString Complete(KIND kind, const wxString& prefix, const std::map<wxString, int>& allowed, size_t max = 20);
+    /* Most used notes of an account (all accounts for accountID <= 0), newest first on a tie */
+    void FrequentNotes(std::vector<wxString>& notes, int accountID);
+
+private:
+    struct Entry
+    {
+        wxString name;
+        wxString lower;
+        int id;
+        bool active;
+    };
+    struct Trans
+    {
+        int account;
+        int payee;
+        wxString notes;
+        wxString date;
+        int category;
+    };
+    struct NoteStat
+    {
+        int count;
+        wxString last;
+    };
+
+    void Sync();
+    void LoadNames(KIND kind);
+    void LoadTransactions();
+    void AddTrans(int id, const Trans& t);
+    void RemoveTrans(int id);
+
+    bool m_names_loaded[KIND_MAX] = { false, false, false };
+    std::vector<Entry> m_names[KIND_MAX];       // display order
+    std::vector<size_t> m_prefix[KIND_MAX];     // indexes into m_names, ordered by lower case name
+
+    bool m_trans_loaded = false;
+    std::unordered_map<int, Trans> m_trans;
+    std::unordered_map<int, int> m_uses[KIND_MAX];                  // id -> transactions using it
+    std::map<int, std::unordered_map<wxString, NoteStat>> m_notes;   // key -1 holds all accounts
+    std::map<int, std::vector<wxString>> m_top_notes;
+
+    std::set<int> m_pending_trans;
+};
+
+#endif // MM_EX_AUTOCOMPLETE_H_
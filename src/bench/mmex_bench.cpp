@@ -0,0 +1,750 @@
+/*******************************************************
+ Copyright (C) 2026 MoneyManagerEx contributors
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+/*
+mmex_bench: headless benchmark driver (cmake -DMMEX_BENCH=ON).
+Generates a deterministic synthetic database and times the standard
+scenarios through the same model and report code that mmex runs, writing
+the results as JSON so that runs from different builds can be compared.
+
+    mmex_bench --transactions 200000 --repeat 5 --output before.json
+*/
+
+#include "autocomplete.h"
+#include "constants.h"
+#include "dbupgrade.h"
+#include "dbwrapper.h"
+#include "mmhomepage.h"
+#include "option.h"
+#include "util.h"
+#include "import_export/parsers.h"
+#include "model/allmodel.h"
+#include "reports/allreport.h"
+
+#include <wx/cmdline.h>
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/init.h>
+#include <wx/stopwatch.h>
+#include <wx/tokenzr.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <random>
+
+namespace
+{
+struct Scale
+{
+    long accounts = 20;
+    long payees = 500;
+    long categories = 100;
+    long transactions = 100000;
+    long splits = 5;        // percent of transactions with splits
+    long currencies = 5;
+    long history = 3650;    // days of currency and stock prices
+    long stocks = 10;
+    long assets = 10;
+    long seed = 1;
+    wxDate epoch = wxDate(31, wxDateTime::Dec, 2025); // last day of the history, not today, so runs compare
+};
+
+/*
+Fills an empty database through the models. std::mt19937 output is fixed by
+the standard, and only its raw output is used, so a given seed produces the
+same database with any compiler.
+*/
+class Generator
+{
+public:
+    explicit Generator(const Scale& scale) : m_scale(scale), m_rng(static_cast<unsigned long>(scale.seed)) {}
+    void Run();
+
+private:
+    long Pick(long n) { return n > 0 ? static_cast<long>(m_rng() % static_cast<unsigned long>(n)) : 0; }
+    double Amount(double max) { return std::round(max * (m_rng() % 100000) / 1000.0) / 100.0; }
+    const wxString DaysAgo(long days) const { return (m_scale.epoch - wxDateSpan::Days(static_cast<int>(days))).FormatISODate(); }
+
+    void Currencies();
+    void Categories();
+    void Payees();
+    void Accounts();
+    void Transactions();
+    void Stocks();
+    void Assets();
+    void Budget();
+
+    Scale m_scale;
+    std::mt19937 m_rng;
+    std::vector<int> m_currencies, m_categories, m_payees, m_accounts;
+    int m_investment = -1;
+};
+
+void Generator::Run()
+{
+    Model_Checking::instance().Savepoint("MMEX_Bench");
+    Currencies();
+    Categories();
+    Payees();
+    Accounts();
+    Transactions();
+    Stocks();
+    Assets();
+    Budget();
+    Model_Checking::instance().ReleaseSavepoint("MMEX_Bench");
+}
+
+void Generator::Currencies()
+{
+    // CURRENCYFORMATS_V1 is seeded on creation; USD is the base currency
+    Option::instance().setBaseCurrency(1);
+    for (long i = 1; i <= m_scale.currencies; i++)
+    {
+        const Model_Currency::Data* currency = Model_Currency::instance().get(static_cast<int>(i));
+        if (!currency || currency->CURRENCYID != i) break;
+        m_currencies.push_back(currency->CURRENCYID);
+        if (i == 1) continue;
+
+        double rate = 0.5 + Amount(1.5);
+        for (long day = m_scale.history; day >= 0; day--)
+        {
+            rate *= 1.0 + (static_cast<double>(Pick(2001)) - 1000.0) / 100000.0;
+            Model_CurrencyHistory::Data* h = Model_CurrencyHistory::instance().create();
+            h->CURRENCYID = currency->CURRENCYID;
+            h->CURRDATE = DaysAgo(day);
+            h->CURRVALUE = rate;
+            h->CURRUPDTYPE = Model_CurrencyHistory::ONLINE;
+            Model_CurrencyHistory::instance().save(h);
+        }
+    }
+}
+
+void Generator::Categories()
+{
+    const long parents = std::max(1L, m_scale.categories / 4);
+    std::vector<int> parent_ids;
+    for (long i = 0; i < m_scale.categories; i++)
+    {
+        Model_Category::Data* c = Model_Category::instance().create();
+        const bool is_parent = i < parents;
+        c->CATEGNAME = wxString::Format("%s %ld", is_parent ? "Category" : "Subcategory", i);
+        c->PARENTID = is_parent ? -1 : parent_ids[i % parents];
+        c->ACTIVE = 1;
+        const int id = Model_Category::instance().save(c);
+        if (is_parent) parent_ids.push_back(id);
+        m_categories.push_back(id);
+    }
+}
+
+void Generator::Payees()
+{
+    for (long i = 0; i < m_scale.payees; i++)
+    {
+        Model_Payee::Data* p = Model_Payee::instance().create();
+        p->PAYEENAME = wxString::Format("Payee %ld", i);
+        p->CATEGID = m_categories.empty() ? -1 : m_categories[Pick(m_categories.size())];
+        p->ACTIVE = 1;
+        m_payees.push_back(Model_Payee::instance().save(p));
+    }
+}
+
+void Generator::Accounts()
+{
+    static const Model_Account::TYPE types[] = {
+        Model_Account::CHECKING, Model_Account::CHECKING, Model_Account::CREDIT_CARD
+        , Model_Account::CASH, Model_Account::TERM, Model_Account::LOAN };
+
+    for (long i = 0; i <= m_scale.accounts; i++)
+    {
+        const bool investment = i == m_scale.accounts;
+        Model_Account::Data* a = Model_Account::instance().create();
+        a->ACCOUNTNAME = investment ? wxString("Investments") : wxString::Format("Account %ld", i);
+        a->ACCOUNTTYPE = Model_Account::all_type()[investment ? Model_Account::INVESTMENT : types[i % WXSIZEOF(types)]];
+        a->STATUS = Model_Account::all_status()[Model_Account::OPEN];
+        a->FAVORITEACCT = "TRUE";
+        a->INITIALBAL = investment ? 0 : Amount(10000);
+        a->INITIALDATE = DaysAgo(m_scale.history);
+        a->CURRENCYID = i % 4 == 3 ? m_currencies[Pick(m_currencies.size())] : m_currencies.front();
+        const int id = Model_Account::instance().save(a);
+        if (investment)
+            m_investment = id;
+        else
+            m_accounts.push_back(id);
+    }
+}
+
+void Generator::Transactions()
+{
+    if (m_accounts.empty() || m_payees.empty() || m_categories.empty()) return;
+
+    const wxArrayString& codes = Model_Checking::all_type();
+    const wxArrayString& statuses = Model_Checking::all_status();
+    for (long i = 0; i < m_scale.transactions; i++)
+    {
+        Model_Checking::Data* t = Model_Checking::instance().create();
+        const long kind = Pick(20);
+        const long accounts = m_accounts.size();
+        const Model_Checking::TYPE type = kind < 2 && accounts > 1 ? Model_Checking::TRANSFER
+            : (kind < 6 ? Model_Checking::DEPOSIT : Model_Checking::WITHDRAWAL);
+        const long from = Pick(accounts);
+        t->ACCOUNTID = m_accounts[from];
+        t->TOACCOUNTID = type == Model_Checking::TRANSFER ? m_accounts[(from + 1 + Pick(accounts - 1)) % accounts] : -1;
+        t->PAYEEID = type == Model_Checking::TRANSFER ? -1 : m_payees[Pick(m_payees.size())];
+        t->TRANSCODE = codes[type];
+        t->TRANSAMOUNT = Amount(type == Model_Checking::DEPOSIT ? 5000 : 500);
+        t->TOTRANSAMOUNT = t->TRANSAMOUNT;
+        t->STATUS = Model_Checking::toShortStatus(statuses[Pick(10) < 6 ? Model_Checking::RECONCILED : Pick(statuses.size())]);
+        t->TRANSACTIONNUMBER = Pick(4) == 0 ? wxString::Format("%ld", i) : "";
+        t->NOTES = Pick(3) == 0 ? wxString::Format("Note %ld", Pick(200)) : "";
+        t->TRANSDATE = DaysAgo(Pick(m_scale.history));
+        t->FOLLOWUPID = -1;
+
+        const bool split = type != Model_Checking::TRANSFER && Pick(100) < m_scale.splits;
+        t->CATEGID = split ? -1 : m_categories[Pick(m_categories.size())];
+        const int id = Model_Checking::instance().save(t);
+
+        if (!split) continue;
+        const long parts = 2 + Pick(3);
+        for (long p = 0; p < parts; p++)
+        {
+            Model_Splittransaction::Data* s = Model_Splittransaction::instance().create();
+            s->TRANSID = id;
+            s->CATEGID = m_categories[Pick(m_categories.size())];
+            s->SPLITTRANSAMOUNT = t->TRANSAMOUNT / parts;
+            Model_Splittransaction::instance().save(s);
+        }
+    }
+}
+
+void Generator::Stocks()
+{
+    for (long i = 0; i < m_scale.stocks; i++)
+    {
+        const wxString symbol = wxString::Format("BENCH%ld", i);
+        double price = 10 + Amount(200);
+
+        Model_Stock::Data* s = Model_Stock::instance().create();
+        s->HELDAT = m_investment;
+        s->PURCHASEDATE = DaysAgo(m_scale.history);
+        s->STOCKNAME = wxString::Format("Stock %ld", i);
+        s->SYMBOL = symbol;
+        s->NUMSHARES = 1 + Pick(500);
+        s->PURCHASEPRICE = price;
+
+        for (long day = m_scale.history; day >= 0; day--)
+        {
+            price = std::max(0.01, price * (1.0 + (static_cast<double>(Pick(2001)) - 1000.0) / 50000.0));
+            Model_StockHistory::Data* h = Model_StockHistory::instance().create();
+            h->SYMBOL = symbol;
+            h->DATE = DaysAgo(day);
+            h->VALUE = price;
+            h->UPDTYPE = Model_StockHistory::ONLINE;
+            Model_StockHistory::instance().save(h);
+        }
+
+        s->CURRENTPRICE = price;
+        s->VALUE = s->NUMSHARES * price;
+        Model_Stock::instance().save(s);
+    }
+}
+
+void Generator::Assets()
+{
+    for (long i = 0; i < m_scale.assets; i++)
+    {
+        Model_Asset::Data* a = Model_Asset::instance().create();
+        a->ASSETNAME = wxString::Format("Asset %ld", i);
+        a->ASSETTYPE = Model_Asset::all_type()[i % Model_Asset::TYPE_CHOICES.size()];
+        a->ASSETSTATUS = Model_Asset::OPEN_STR;
+        a->STARTDATE = DaysAgo(Pick(m_scale.history));
+        a->CURRENCYID = m_currencies.front();
+        a->VALUE = Amount(100000);
+        a->VALUECHANGE = Model_Asset::all_rate()[i % Model_Asset::RATE_CHOICES.size()];
+        a->VALUECHANGEMODE = Model_Asset::PERCENTAGE_STR;
+        a->VALUECHANGERATE = 1 + Pick(10);
+        Model_Asset::instance().save(a);
+    }
+}
+
+void Generator::Budget()
+{
+    Model_Budgetyear::Data* y = Model_Budgetyear::instance().create();
+    y->BUDGETYEARNAME = wxString::Format("%d", m_scale.epoch.GetYear());
+    const int year_id = Model_Budgetyear::instance().save(y);
+
+    for (const auto categ_id : m_categories)
+    {
+        Model_Budget::Data* b = Model_Budget::instance().create();
+        b->BUDGETYEARID = year_id;
+        b->CATEGID = categ_id;
+        b->PERIOD = Model_Budget::all_period()[Model_Budget::MONTHLY];
+        b->AMOUNT = -Amount(1000);
+        b->ACTIVE = 1;
+        Model_Budget::instance().save(b);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/* Same table set as mmGUIFrame::InitializeModelTables */
+void InitializeModels(wxSQLite3Database* db)
+{
+    mmAutoComplete::instance().Reset();
+    Model_Infotable::instance(db);
+    Model_Asset::instance(db);
+    Model_Stock::instance(db);
+    Model_StockHistory::instance(db);
+    Model_Account::instance(db);
+    Model_Payee::instance(db);
+    Model_Checking::instance(db);
+    Model_Currency::instance(db);
+    Model_CurrencyHistory::instance(db);
+    Model_Budgetyear::instance(db);
+    Model_Category::instance(db);
+    Model_Billsdeposits::instance(db);
+    Model_Splittransaction::instance(db);
+    Model_Budgetsplittransaction::instance(db);
+    Model_Budget::instance(db);
+    Model_Report::instance(db);
+    Model_Attachment::instance(db);
+    Model_CustomFieldData::instance(db);
+    Model_CustomField::instance(db);
+    Model_Translink::instance(db);
+    Model_Shareinfo::instance(db);
+}
+
+wxSharedPtr<wxSQLite3Database> OpenDatabase(const wxString& path)
+{
+    wxSharedPtr<wxSQLite3Database> db = mmDBWrapper::Open(path);
+    if (!db) return db;
+    if (dbUpgrade::isUpgradeDBrequired(db.get()) && !dbUpgrade::UpgradeDB(db.get(), path))
+    {
+        db->Close();
+        db.reset();
+        return db;
+    }
+    InitializeModels(db.get());
+    // LoadOptions() asks for the base currency with a dialog when none is stored
+    if (Model_Infotable::instance().GetIntInfo("BASECURRENCYID", -1) < 1)
+        Option::instance().setBaseCurrency(1);
+    Option::instance().LoadOptions();
+    return db;
+}
+
+void CloseDatabase(wxSharedPtr<wxSQLite3Database>& db)
+{
+    if (!db) return;
+    // the info and setting tables buffer their writes, store them while the database is open
+    Model_Infotable::instance().Flush();
+    Model_Setting::instance().Flush();
+    db->Close();
+    db.reset();
+    mmAutoComplete::instance().Reset();
+}
+
+//----------------------------------------------------------------------------
+
+struct Timing
+{
+    wxString name;
+    std::vector<double> ms;
+};
+
+class Bench
+{
+public:
+    Bench(const wxString& path, long repeat, const wxDate& epoch) : m_path(path), m_repeat(std::max(1L, repeat)), m_epoch(epoch) {}
+
+    bool Run();
+    void Write(PrettyWriter<StringBuffer>& json_writer) const;
+
+private:
+    void Measure(const wxString& name, const std::function<void()>& scenario, const std::function<void()>& reset = nullptr);
+
+    void HomePage();
+    void AccountView();
+    void Reports();
+    void ExportCSV(const wxString& file);
+    void ImportCSV(const wxString& file);
+
+    wxString m_path;
+    long m_repeat;
+    wxDate m_epoch;
+    wxSharedPtr<wxSQLite3Database> m_db;
+    std::vector<Timing> m_results;
+};
+
+void Bench::Measure(const wxString& name, const std::function<void()>& scenario, const std::function<void()>& reset)
+{
+    Timing timing;
+    timing.name = name;
+    for (long i = 0; i < m_repeat; i++)
+    {
+        wxStopWatch sw;
+        scenario();
+        timing.ms.push_back(sw.TimeInMicro().ToDouble() / 1000.0);
+        if (reset) reset();
+    }
+    wxPrintf("%-48s %10.1f ms\n", name, *std::min_element(timing.ms.begin(), timing.ms.end()));
+    m_results.push_back(timing);
+}
+
+bool Bench::Run()
+{
+    Measure("open_database", [this]() { m_db = OpenDatabase(m_path); }, [this]() { CloseDatabase(m_db); });
+    m_db = OpenDatabase(m_path);
+    if (!m_db) return false;
+
+    Measure("homepage", [this]() { HomePage(); });
+    Measure("account_view", [this]() { AccountView(); });
+    Reports();
+
+    const wxString file = wxFileName::CreateTempFileName("mmex_bench");
+    Measure("csv_export", [this, &file]() { ExportCSV(file); });
+    // each import is rolled back so that every run sees the same database
+    Measure("csv_import", [this, &file]() { ImportCSV(file); }, [this]() { InitializeModels(m_db.get()); });
+    wxRemoveFile(file);
+
+    CloseDatabase(m_db);
+    return true;
+}
+
+/* The widgets mmHomePagePanel::insertDataIntoTemplate renders */
+void Bench::HomePage()
+{
+    double tBalance = 0.0, tReconciled = 0.0;
+    htmlWidgetAccounts account_stats;
+    for (const auto type : { Model_Account::CHECKING, Model_Account::CREDIT_CARD, Model_Account::CASH, Model_Account::LOAN, Model_Account::TERM })
+    {
+        double balance = 0.0, reconciled = 0.0;
+        account_stats.displayAccounts(balance, reconciled, type);
+        tBalance += balance;
+        tReconciled += reconciled;
+    }
+
+    htmlWidgetStocks stocks_widget;
+    stocks_widget.getHTMLText();
+    htmlWidgetAssets assets;
+    assets.getHTMLText();
+    htmlWidgetGrandTotals grand_totals;
+    grand_totals.getHTMLText(tBalance, tReconciled, Model_Asset::instance().balance(), stocks_widget.get_total());
+    htmlWidgetIncomeVsExpenses income_vs_expenses;
+    income_vs_expenses.getHTMLText();
+    htmlWidgetBillsAndDeposits bills_and_deposits(_("Upcoming Transactions"));
+    bills_and_deposits.getHTMLText();
+    htmlWidgetTop7Categories top_trx;
+    top_trx.getHTMLText();
+    htmlWidgetStatistics stat_widget;
+    stat_widget.getHTMLText();
+    htmlWidgetCurrency currency_rates;
+    currency_rates.getHtmlText();
+}
+
+/* The data side of mmCheckingPanel::filterTable for every bank account */
+void Bench::AccountView()
+{
+    const auto splits = Model_Splittransaction::instance().get_all();
+    for (const auto& account : Model_Account::instance().all())
+    {
+        if (Model_Account::type(account) == Model_Account::INVESTMENT) continue;
+
+        Model_Checking::Full_Data_Set trans;
+        double balance = account.INITIALBAL;
+        for (const auto& tran : Model_Account::transaction(account))
+        {
+            Model_Checking::Full_Data full_tran(tran, splits);
+            full_tran.AMOUNT = Model_Checking::amount(tran, account.ACCOUNTID);
+            balance += Model_Checking::balance(tran, account.ACCOUNTID);
+            full_tran.BALANCE = balance;
+            trans.push_back(full_tran);
+        }
+        std::stable_sort(trans.begin(), trans.end(), SorterByTRANSDATE());
+    }
+}
+
+void Bench::Reports()
+{
+    std::vector<std::pair<wxString, std::function<mmPrintableBase*()> > > reports = {
+        { "report_cashflow_daily", []() { return new mmReportCashFlowDaily(); } }
+        , { "report_cashflow_monthly", []() { return new mmReportCashFlowMonthly(); } }
+        , { "report_cashflow_transactions", []() { return new mmReportCashFlowTransactions(); } }
+        , { "report_categories_monthly", []() { return new mmReportCategoryOverTimePerformance(); } }
+        , { "report_categories_summary", []() { return new mmReportCategoryExpensesCategories(); } }
+        , { "report_where_money_goes", []() { return new mmReportCategoryExpensesGoes(); } }
+        , { "report_where_money_comes", []() { return new mmReportCategoryExpensesComes(); } }
+        , { "report_forecast", []() { return new mmReportForecast(); } }
+        , { "report_income_vs_expenses", []() { return new mmReportIncomeExpenses(); } }
+        , { "report_income_vs_expenses_monthly", []() { return new mmReportIncomeExpensesMonthly(); } }
+        , { "report_payees", []() { return new mmReportPayeeExpenses(); } }
+        , { "report_summary_monthly", []() { return new mmReportSummaryByDateMontly(); } }
+        , { "report_summary_yearly", []() { return new mmReportSummaryByDateYearly(); } }
+        , { "report_budget_performance", []() { return new mmReportBudgetingPerformance(); } }
+        , { "report_budget_category_summary", []() { return new mmReportBudgetCategorySummary(); } }
+        , { "report_stocks", []() { return new mmReportChartStocks(); } }
+        , { "report_stocks_summary", []() { return new mmReportSummaryStocks(); } }
+    };
+
+    // the parameters a freshly opened mmReportsPanel would pass, with the epoch as today
+    const mmSpecifiedRange last12months(wxDate(1, m_epoch.GetMonth(), m_epoch.GetYear()).Subtract(wxDateSpan::Months(11))
+        , m_epoch.GetLastMonthDay());
+    const Model_Budgetyear::Data_Set years = Model_Budgetyear::instance().all();
+    for (const auto& entry : reports)
+    {
+        std::unique_ptr<mmPrintableBase> report(entry.second());
+        const int rp = report->report_parameters();
+        if (rp & mmPrintableBase::DATE_RANGE)
+            report->date_range(&last12months, 0);
+        if (rp & mmPrintableBase::ONLY_YEARS)
+            report->setSelection(m_epoch.GetYear());
+        if (rp & mmPrintableBase::BUDGET_DATES)
+        {
+            if (years.empty()) continue;
+            report->setSelection(years.back().BUDGETYEARID);
+        }
+        Measure(entry.first, [&report]() { report->getHTMLText(); });
+    }
+}
+
+/* Rows in the univcsv default layout: date, payee, amount, category, number, notes */
+void Bench::ExportCSV(const wxString& file)
+{
+    const auto splits = Model_Splittransaction::instance().get_all();
+    FileCSV csv(nullptr, wxConvAuto(wxFONTENCODING_UTF8), ",");
+    for (const auto& tran : Model_Checking::instance().all())
+    {
+        if (Model_Checking::type(tran) == Model_Checking::TRANSFER) continue;
+        Model_Checking::Full_Data full_tran(tran, splits);
+        csv.AddNewLine();
+        csv.AddNewItem(full_tran.TRANSDATE);
+        csv.AddNewItem(full_tran.PAYEENAME);
+        csv.AddNewItem(wxString::FromCDouble(Model_Checking::amount(tran, tran.ACCOUNTID), 2), ITransactionsFile::TYPE_NUMBER);
+        csv.AddNewItem(full_tran.m_splits.empty() ? Model_Category::full_name(tran.CATEGID, ":") : "");
+        csv.AddNewItem(full_tran.TRANSACTIONNUMBER);
+        csv.AddNewItem(full_tran.NOTES);
+    }
+    // wxTextFile::Create refuses to overwrite
+    if (wxFileName::FileExists(file)) wxRemoveFile(file);
+    csv.Save(file);
+}
+
+/* The lookups mmUnivCSVDialog::ParseToken performs for each row */
+void Bench::ImportCSV(const wxString& file)
+{
+    FileCSV csv(nullptr, wxConvAuto(wxFONTENCODING_UTF8), ",");
+    if (!csv.Load(file, 6)) return;
+
+    const Model_Account::Data_Set accounts = Model_Account::instance().find(
+        Model_Account::ACCOUNTTYPE(Model_Account::all_type()[Model_Account::INVESTMENT], NOT_EQUAL));
+    if (accounts.empty()) return;
+    const wxArrayString& codes = Model_Checking::all_type();
+
+    Model_Checking::instance().Savepoint("MMEX_BenchImport");
+    for (unsigned int line = 0; line < csv.GetLinesCount(); line++)
+    {
+        wxDateTime date;
+        double amount = 0.0;
+        if (!mmParseISODate(csv.GetItem(line, 0), date) || !csv.GetItem(line, 2).ToCDouble(&amount))
+            continue;
+
+        const Model_Payee::Data* payee = Model_Payee::instance().get(csv.GetItem(line, 1));
+        int categ_id = -1;
+        wxStringTokenizer categs(csv.GetItem(line, 3), ":");
+        while (categs.HasMoreTokens())
+        {
+            const Model_Category::Data* category = Model_Category::instance().get(categs.GetNextToken(), categ_id);
+            if (!category) break;
+            categ_id = category->CATEGID;
+        }
+
+        Model_Checking::Data* t = Model_Checking::instance().create();
+        t->ACCOUNTID = accounts[line % accounts.size()].ACCOUNTID;
+        t->TOACCOUNTID = -1;
+        t->PAYEEID = payee ? payee->PAYEEID : -1;
+        t->TRANSCODE = codes[amount > 0 ? Model_Checking::DEPOSIT : Model_Checking::WITHDRAWAL];
+        t->TRANSAMOUNT = fabs(amount);
+        t->TOTRANSAMOUNT = t->TRANSAMOUNT;
+        t->TRANSDATE = date.FormatISODate();
+        t->CATEGID = categ_id;
+        t->TRANSACTIONNUMBER = csv.GetItem(line, 4);
+        t->NOTES = csv.GetItem(line, 5);
+        t->FOLLOWUPID = -1;
+        Model_Checking::instance().save(t);
+    }
+    Model_Checking::instance().Rollback("MMEX_BenchImport");
+    Model_Checking::instance().ReleaseSavepoint("MMEX_BenchImport");
+}
+
+void Bench::Write(PrettyWriter<StringBuffer>& json_writer) const
+{
+    json_writer.Key("results");
+    json_writer.StartArray();
+    for (const auto& timing : m_results)
+    {
+        std::vector<double> ms = timing.ms;
+        std::sort(ms.begin(), ms.end());
+        json_writer.StartObject();
+        json_writer.Key("name");
+        json_writer.String(timing.name.utf8_str());
+        json_writer.Key("runs");
+        json_writer.Int(static_cast<int>(ms.size()));
+        json_writer.Key("min_ms");
+        json_writer.Double(ms.front());
+        json_writer.Key("median_ms");
+        json_writer.Double(ms[ms.size() / 2]);
+        json_writer.Key("max_ms");
+        json_writer.Double(ms.back());
+        json_writer.EndObject();
+    }
+    json_writer.EndArray();
+}
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] =
+{
+    { wxCMD_LINE_SWITCH, "h", "help", "", wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "d", "db", "database to generate (default: a temporary file)" },
+    { wxCMD_LINE_SWITCH, "k", "keep", "reuse --db as is instead of regenerating it" },
+    { wxCMD_LINE_OPTION, "o", "output", "write the JSON results to this file (default: stdout)" },
+    { wxCMD_LINE_OPTION, "r", "repeat", "runs per scenario (default: 3)", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, nullptr, "seed", "random seed (default: 1)", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, nullptr, "accounts", "bank accounts (default: 20)", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, nullptr, "payees", "payees (default: 500)", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, nullptr, "categories", "categories and subcategories (default: 100)", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, nullptr, "transactions", "transactions (default: 100000)", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, nullptr, "splits", "percent of transactions with splits (default: 5)", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, nullptr, "currencies", "currencies with rate history (default: 5)", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, nullptr, "history", "days of transactions and prices (default: 3650)", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, nullptr, "stocks", "stocks with daily price history (default: 10)", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, nullptr, "assets", "assets (default: 10)", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, nullptr, "epoch", "last day of the history, YYYY-MM-DD (default: 2025-12-31)" },
+    { wxCMD_LINE_NONE }
+};
+} // namespace
+
+int main(int argc, char** argv)
+{
+    wxInitializer initializer(argc, argv);
+    if (!initializer.IsOk())
+    {
+        fprintf(stderr, "mmex_bench: failed to initialize wxWidgets\n");
+        return EXIT_FAILURE;
+    }
+
+    wxCmdLineParser parser(g_cmdLineDesc, argc, argv);
+    if (parser.Parse() != 0) return EXIT_FAILURE;
+
+    Scale scale;
+    long repeat = 3;
+    parser.Found("repeat", &repeat);
+    parser.Found("seed", &scale.seed);
+    parser.Found("accounts", &scale.accounts);
+    parser.Found("payees", &scale.payees);
+    parser.Found("categories", &scale.categories);
+    parser.Found("transactions", &scale.transactions);
+    parser.Found("splits", &scale.splits);
+    parser.Found("currencies", &scale.currencies);
+    parser.Found("history", &scale.history);
+    parser.Found("stocks", &scale.stocks);
+    parser.Found("assets", &scale.assets);
+    wxString epoch;
+    if (parser.Found("epoch", &epoch) && !scale.epoch.ParseISODate(epoch))
+    {
+        fprintf(stderr, "mmex_bench: invalid --epoch %s\n", static_cast<const char*>(epoch.utf8_str()));
+        return EXIT_FAILURE;
+    }
+    scale.history = std::max(1L, scale.history);
+    scale.currencies = std::max(1L, scale.currencies);
+
+    wxString path, output;
+    if (!parser.Found("db", &path))
+    {
+        path = wxFileName::CreateTempFileName("mmex_bench");
+        wxRemoveFile(path);
+        path += ".mmb";
+    }
+    parser.Found("output", &output);
+    const bool keep = parser.Found("keep") && wxFileName::FileExists(path);
+
+    // settings live in memory so the user's mmexini.db3 is never touched
+    wxSQLite3Database setting_db;
+    setting_db.Open(":memory:");
+    Model_Setting::instance(&setting_db);
+    Model_Usage::instance(&setting_db);
+    Option::instance().LoadOptions(false);
+
+    wxStopWatch sw;
+    if (!keep)
+    {
+        if (wxFileName::FileExists(path)) wxRemoveFile(path);
+        wxSharedPtr<wxSQLite3Database> db = mmDBWrapper::Open(path);
+        if (!db)
+        {
+            fprintf(stderr, "mmex_bench: cannot create %s\n", static_cast<const char*>(path.utf8_str()));
+            return EXIT_FAILURE;
+        }
+        dbUpgrade::InitializeVersion(db.get());
+        InitializeModels(db.get());
+        Generator(scale).Run();
+        CloseDatabase(db);
+        wxPrintf("%-48s %10.1f ms\n", "generate", sw.TimeInMicro().ToDouble() / 1000.0);
+    }
+
+    Bench bench(path, repeat, scale.epoch);
+    if (!bench.Run())
+    {
+        fprintf(stderr, "mmex_bench: cannot open %s\n", static_cast<const char*>(path.utf8_str()));
+        return EXIT_FAILURE;
+    }
+
+    StringBuffer json_buffer;
+    PrettyWriter<StringBuffer> json_writer(json_buffer);
+    json_writer.StartObject();
+    json_writer.Key("version");
+    json_writer.String(mmex::version::string.utf8_str());
+    json_writer.Key("database");
+    json_writer.String(path.utf8_str());
+    json_writer.Key("scale");
+    json_writer.StartObject();
+    for (const auto& item : std::vector<std::pair<const char*, long> >{
+        { "seed", scale.seed }, { "accounts", scale.accounts }, { "payees", scale.payees }
+        , { "categories", scale.categories }, { "transactions", scale.transactions }, { "splits", scale.splits }
+        , { "currencies", scale.currencies }, { "history", scale.history }, { "stocks", scale.stocks }
+        , { "assets", scale.assets } })
+    {
+        json_writer.Key(item.first);
+        json_writer.Int64(item.second);
+    }
+    json_writer.Key("epoch");
+    json_writer.String(scale.epoch.FormatISODate().utf8_str());
+    json_writer.EndObject();
+    bench.Write(json_writer);
+    json_writer.EndObject();
+
+    if (output.empty())
+        printf("%s\n", json_buffer.GetString());
+    else
+    {
+        wxFFile file(output, "w");
+        if (!file.IsOpened() || !file.Write(wxString::FromUTF8(json_buffer.GetString())))
+            return EXIT_FAILURE;
+    }
+
+    if (!keep) wxRemoveFile(path);
+    setting_db.Close();
+    return EXIT_SUCCESS;
+}
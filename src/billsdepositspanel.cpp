@@ -796,16 +796,16 @@ void mmBillsDepositsPanel::sortTable()
         std::stable_sort(bills_.begin(), bills_.end(), SorterByNEXTOCCURRENCEDATE());
         break;
     case COL_ACCOUNT:
-        std::stable_sort(bills_.begin(), bills_.end(), SorterByACCOUNTNAME());
+        sort_by_key(bills_, SorterByACCOUNTNAME());
         break;
     case COL_PAYEE:
-        std::stable_sort(bills_.begin(), bills_.end(), SorterByPAYEENAME());
+        sort_by_key(bills_, SorterByPAYEENAME());
         break;
     case COL_STATUS:
         std::stable_sort(bills_.begin(), bills_.end(), SorterBySTATUS());
         break;
     case COL_CATEGORY:
-        std::stable_sort(bills_.begin(), bills_.end(), SorterByCATEGNAME());
+        sort_by_key(bills_, SorterByCATEGNAME());
         break;
     case COL_TYPE:
         std::stable_sort(bills_.begin(), bills_.end(), SorterByTRANSCODE());
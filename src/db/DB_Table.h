@@ -20,6 +20,10 @@
 
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <memory>
+#include <string>
+#include <cstdint>
 #include <algorithm>
 #include <functional>
 #include <cwchar>
@@ -35,6 +39,8 @@ using namespace rapidjson;
 #include "html_template.h"
 using namespace tmpl;
 
+#include "mmDate.h"
+
 class wxString;
 enum OP { EQUAL = 0, GREATER, LESS, GREATER_OR_EQUAL, LESS_OR_EQUAL, NOT_EQUAL };
 
@@ -159,6 +165,136 @@ bool match(const DATA* data, const Arg1& arg1, const Args&... args)
         return false; // Short-circuit evaluation
 }
 
+/**
+Locale case-insensitive sort key of a string: comparing two keys with <
+orders the strings as wcscoll() of their lower case forms does.
+*/
+inline std::wstring collation_key(const wxString& s)
+{
+    const std::wstring lower = s.Lower().ToStdWstring();
+    std::vector<wchar_t> key(std::wcsxfrm(nullptr, lower.c_str(), 0) + 1);
+    const size_t n = std::wcsxfrm(key.data(), lower.c_str(), key.size());
+    return std::wstring(key.data(), n);
+}
+
+/**
+Stable sort of the rows by the key() of a sorter, e.g. sort_by_key(payees, SorterByPAYEENAME()).
+The key is computed once per row instead of twice per comparison, and the
+rows are put in place once instead of being swapped around by the sort.
+*/
+template<class DATA, class SORTER>
+void sort_by_key(std::vector<DATA>& rows, const SORTER&)
+{
+    typedef decltype(SORTER::key(rows.front())) KEY;
+    std::vector<std::pair<KEY, size_t> > keys;
+    keys.reserve(rows.size());
+    for (size_t i = 0; i < rows.size(); i++)
+        keys.push_back(std::make_pair(SORTER::key(rows[i]), i));
+    std::stable_sort(keys.begin(), keys.end()
+        , [](const std::pair<KEY, size_t>& x, const std::pair<KEY, size_t>& y) { return x.first < y.first; });
+
+    std::vector<DATA> sorted;
+    sorted.reserve(rows.size());
+    for (const auto& k : keys)
+        sorted.push_back(rows[k.second]);
+    rows.swap(sorted);
+}
+
+struct DB_Str
+{
+    uint32_t offset, length;
+};
+
+/**
+UTF-8 storage for the strings of DB_View rows, one char buffer for all of them.
+Short strings repeat a lot (dates, codes, statuses, symbols) and are stored once.
+*/
+class DB_String_Pool
+{
+public:
+    DB_Str intern(const wxString& s)
+    {
+        const wxScopedCharBuffer utf8 = s.utf8_str();
+        const std::string str(utf8.data(), utf8.length());
+        if (str.size() > INTERN_MAX) return append(str);
+
+        const auto it = index_.find(str);
+        if (it != index_.end()) return it->second;
+        const DB_Str r = append(str);
+        index_.insert(std::make_pair(str, r));
+        return r;
+    }
+
+    wxString get(const DB_Str& s) const
+    {
+        return s.length ? wxString::FromUTF8(chars_.data() + s.offset, s.length) : wxString();
+    }
+
+    /** Release the intern index and the spare capacity once no more strings are added */
+    void freeze()
+    {
+        std::unordered_map<std::string, DB_Str>().swap(index_);
+        chars_.shrink_to_fit();
+    }
+
+    size_t size() const { return chars_.size(); }
+
+private:
+    static const size_t INTERN_MAX = 32;
+
+    DB_Str append(const std::string& s)
+    {
+        const DB_Str r = { static_cast<uint32_t>(chars_.size()), static_cast<uint32_t>(s.size()) };
+        chars_.insert(chars_.end(), s.begin(), s.end());
+        return r;
+    }
+
+    std::vector<char> chars_;
+    std::unordered_map<std::string, DB_Str> index_;
+};
+
+/**
+A read-only query result of a large table kept compact: each row of the
+result set is read into a TABLE::Row, numbers in place and strings in a
+DB_String_Pool, without building a TABLE::Data. Copies share the storage.
+Loops read rows() directly, with str() for the string columns.
+*/
+template<class TABLE>
+class DB_View
+{
+public:
+    typedef typename TABLE::Row Row;
+
+    DB_View(): arena_(std::make_shared<Arena>()) {}
+
+    /** Pack the remaining rows of the result set */
+    explicit DB_View(wxSQLite3ResultSet& q)
+    {
+        std::shared_ptr<Arena> arena = std::make_shared<Arena>();
+        while (q.NextRow())
+            arena->rows.push_back(TABLE::pack(q, arena->pool));
+        arena->rows.shrink_to_fit();
+        arena->pool.freeze();
+        arena_ = arena;
+    }
+
+    size_t size() const { return arena_->rows.size(); }
+    bool empty() const { return arena_->rows.empty(); }
+
+    const std::vector<Row>& rows() const { return arena_->rows; }
+    /** A string column of one of the rows */
+    wxString str(const DB_Str& s) const { return arena_->pool.get(s); }
+
+private:
+    struct Arena
+    {
+        std::vector<Row> rows;
+        DB_String_Pool pool;
+    };
+
+    std::shared_ptr<const Arena> arena_;
+};
+
 struct SorterByACCESSINFO
 { 
     template<class DATA>
@@ -184,6 +320,11 @@ struct SorterByACCOUNTNAME
     {
         return (std::wcscoll(x.ACCOUNTNAME.Lower().wc_str(),y.ACCOUNTNAME.Lower().wc_str()) < 0);  // Locale case-insensitive
     }
+    template<class DATA>
+    static std::wstring key(const DATA& x)
+    {
+        return collation_key(x.ACCOUNTNAME);
+    }
 };
 
 struct SorterByACCOUNTNUM
@@ -328,6 +469,11 @@ struct SorterByCATEGNAME
     {
         return (std::wcscoll(x.CATEGNAME.Lower().wc_str(),y.CATEGNAME.Lower().wc_str()) < 0);  // Locale case-insensitive
     }
+    template<class DATA>
+    static std::wstring key(const DATA& x)
+    {
+        return collation_key(x.CATEGNAME);
+    }
 };
 
 struct SorterByCENT_NAME
@@ -715,6 +861,11 @@ struct SorterByNOTES
     {
         return (x.NOTES) < (y.NOTES);
     }
+    template<class DATA>
+    static std::wstring key(const DATA& x)
+    {
+        return x.NOTES.ToStdWstring();
+    }
 };
 
 struct SorterByNUMBER
@@ -769,6 +920,11 @@ struct SorterByPAYEENAME
     {
         return (std::wcscoll(x.PAYEENAME.Lower().wc_str(),y.PAYEENAME.Lower().wc_str()) < 0);  // Locale case-insensitive
     }
+    template<class DATA>
+    static std::wstring key(const DATA& x)
+    {
+        return collation_key(x.PAYEENAME);
+    }
 };
 
 struct SorterByPAYMENTDUEDATE
@@ -52,6 +52,8 @@ struct DB_Table_ACCOUNTLIST_V1 : public DB_Table
     typedef std::map<int, Self::Data*> Index_By_Id;
     Cache cache_;
     Index_By_Id index_by_id_;
+    typedef std::unordered_map<std::wstring, int> Index_By_Key;
+    Index_By_Key index_by_ACCOUNTNAME_;
     Data* fake_; // in case the entity not found
 
     /** Destructor: clears any data records stored in memory */
@@ -67,6 +69,7 @@ struct DB_Table_ACCOUNTLIST_V1 : public DB_Table
         std::for_each(cache_.begin(), cache_.end(), std::mem_fn(&Data::destroy));
         cache_.clear();
         index_by_id_.clear(); // no memory release since it just stores pointer and the according objects are in cache
+        index_by_ACCOUNTNAME_.clear();
     }
 
     /** Creates the database table if the table does not exist*/
@@ -373,6 +376,21 @@ struct DB_Table_ACCOUNTLIST_V1 : public DB_Table
             return this->id() < r->id();
         }
 
+        mmDate INITIALDATE_date() const
+        {
+            return mmDate::FromISO(INITIALDATE);
+        }
+
+        mmDate STATEMENTDATE_date() const
+        {
+            return mmDate::FromISO(STATEMENTDATE);
+        }
+
+        mmDate PAYMENTDUEDATE_date() const
+        {
+            return mmDate::FromISO(PAYMENTDUEDATE);
+        }
+
         explicit Data(Self* table = 0) 
         {
             table_ = table;
@@ -781,7 +799,10 @@ struct DB_Table_ACCOUNTLIST_V1 : public DB_Table
                 {
                     Self::Data* e = *it;
                     if (e->id() == entity->id()) 
+                    {
                         *e = *entity;  // in-place update
+                        index_keys(e);
+                    }
                 }
             }
         }
@@ -795,6 +816,7 @@ struct DB_Table_ACCOUNTLIST_V1 : public DB_Table
         {
             entity->id((db->GetLastRowId()).ToLong());
             index_by_id_.insert(std::make_pair(entity->id(), entity));
+            index_keys(entity);
         }
         return true;
     }
@@ -866,6 +888,38 @@ struct DB_Table_ACCOUNTLIST_V1 : public DB_Table
 
         return 0;
     }
+
+    /** Key of ACCOUNTNAME in index_by_ACCOUNTNAME_, case-insensitive like match() */
+    static std::wstring key_ACCOUNTNAME(const wxString& arg1)
+    {
+        return arg1.Lower().ToStdWstring();
+    }
+
+    /** Add the cached record to the natural key indexes */
+    void index_keys(const Self::Data* entity)
+    {
+        index_by_ACCOUNTNAME_[key_ACCOUNTNAME(entity->ACCOUNTNAME)] = entity->id();
+    }
+
+    /** Return the cached record with the given ACCOUNTNAME through the index, without scanning the cache */
+    Self::Data* get_one(const Self::ACCOUNTNAME& arg1)
+    {
+        Index_By_Key::iterator it = index_by_ACCOUNTNAME_.find(key_ACCOUNTNAME(arg1.v_));
+        if (it != index_by_ACCOUNTNAME_.end())
+        {
+            Index_By_Id::iterator entity = index_by_id_.find(it->second);
+            if (entity != index_by_id_.end() && match(entity->second, arg1))
+            {
+                ++ hit_;
+                return entity->second;
+            }
+            index_by_ACCOUNTNAME_.erase(it); // the record was removed or its key changed
+        }
+
+        ++ miss_;
+
+        return 0;
+    }
     
     /**
     * Search the memory table (Cache) for the data record.
@@ -900,6 +954,7 @@ struct DB_Table_ACCOUNTLIST_V1 : public DB_Table
                 entity = new Self::Data(q, this);
                 cache_.push_back(entity);
                 index_by_id_.insert(std::make_pair(id, entity));
+                index_keys(entity);
             }
             stmt.Finalize();
         }
@@ -273,6 +273,11 @@ struct DB_Table_ASSETS_V1 : public DB_Table
             return this->id() < r->id();
         }
 
+        mmDate STARTDATE_date() const
+        {
+            return mmDate::FromISO(STARTDATE);
+        }
+
         explicit Data(Self* table = 0) 
         {
             table_ = table;
@@ -323,6 +323,16 @@ struct DB_Table_BILLSDEPOSITS_V1 : public DB_Table
             return this->id() < r->id();
         }
 
+        mmDate TRANSDATE_date() const
+        {
+            return mmDate::FromISO(TRANSDATE);
+        }
+
+        mmDate NEXTOCCURRENCEDATE_date() const
+        {
+            return mmDate::FromISO(NEXTOCCURRENCEDATE);
+        }
+
         explicit Data(Self* table = 0) 
         {
             table_ = table;
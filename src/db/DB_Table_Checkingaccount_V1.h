@@ -314,6 +314,11 @@ struct DB_Table_CHECKINGACCOUNT_V1 : public DB_Table
             return this->id() < r->id();
         }
 
+        mmDate TRANSDATE_date() const
+        {
+            return mmDate::FromISO(TRANSDATE);
+        }
+
         explicit Data(Self* table = 0) 
         {
             table_ = table;
@@ -571,6 +576,50 @@ struct DB_Table_CHECKINGACCOUNT_V1 : public DB_Table
         }
     };
 
+    /** Data packed into a DB_View: numbers in place, strings in the view's DB_String_Pool */
+    struct Row
+    {
+        double TRANSAMOUNT;
+        double TOTRANSAMOUNT;
+        int TRANSID;
+        int ACCOUNTID;
+        int TOACCOUNTID;
+        int PAYEEID;
+        int CATEGID;
+        int FOLLOWUPID;
+        DB_Str TRANSCODE;
+        DB_Str STATUS;
+        DB_Str TRANSACTIONNUMBER;
+        DB_Str NOTES;
+        DB_Str TRANSDATE;
+        DB_Str LASTUPDATEDTIME;
+        DB_Str DELETEDTIME;
+    };
+
+    /** Read the current row of a result set over query() without building a Data */
+    static Row pack(wxSQLite3ResultSet& q, DB_String_Pool& pool)
+    {
+        Row r;
+        r.TRANSAMOUNT = q.GetDouble(5); // TRANSAMOUNT
+        r.TOTRANSAMOUNT = q.GetDouble(14); // TOTRANSAMOUNT
+        r.TRANSID = q.GetInt(0); // TRANSID
+        r.ACCOUNTID = q.GetInt(1); // ACCOUNTID
+        r.TOACCOUNTID = q.GetInt(2); // TOACCOUNTID
+        r.PAYEEID = q.GetInt(3); // PAYEEID
+        r.CATEGID = q.GetInt(9); // CATEGID
+        r.FOLLOWUPID = q.GetInt(13); // FOLLOWUPID
+        r.TRANSCODE = pool.intern(q.GetString(4)); // TRANSCODE
+        r.STATUS = pool.intern(q.GetString(6)); // STATUS
+        r.TRANSACTIONNUMBER = pool.intern(q.GetString(7)); // TRANSACTIONNUMBER
+        r.NOTES = pool.intern(q.GetString(8)); // NOTES
+        r.TRANSDATE = pool.intern(q.GetString(10)); // TRANSDATE
+        r.LASTUPDATEDTIME = pool.intern(q.GetString(11)); // LASTUPDATEDTIME
+        r.DELETEDTIME = pool.intern(q.GetString(12)); // DELETEDTIME
+        return r;
+    }
+
+    typedef DB_View<Self> View;
+
     enum
     {
         NUM_COLUMNS = 15
@@ -812,5 +861,26 @@ struct DB_Table_CHECKINGACCOUNT_V1 : public DB_Table
 
         return result;
     }
+
+    /**
+    * Return the records as a compact View derived directly from the database,
+    * sorted like all().
+    */
+    const View all_view(wxSQLite3Database* db, COLUMN col = COLUMN(0), bool asc = true)
+    {
+        try
+        {
+            wxSQLite3ResultSet q = db->ExecuteQuery(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "));
+            const View result(q);
+            q.Finalize();
+            return result;
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("%s: Exception %s", this->name().utf8_str(), e.GetMessage().utf8_str());
+        }
+
+        return View();
+    }
 };
 
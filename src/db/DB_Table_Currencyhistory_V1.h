@@ -52,6 +52,8 @@ struct DB_Table_CURRENCYHISTORY_V1 : public DB_Table
     typedef std::map<int, Self::Data*> Index_By_Id;
     Cache cache_;
     Index_By_Id index_by_id_;
+    typedef std::unordered_map<std::wstring, int> Index_By_Key;
+    Index_By_Key index_by_CURRENCYID_CURRDATE_;
     Data* fake_; // in case the entity not found
 
     /** Destructor: clears any data records stored in memory */
@@ -67,6 +69,7 @@ struct DB_Table_CURRENCYHISTORY_V1 : public DB_Table
         std::for_each(cache_.begin(), cache_.end(), std::mem_fn(&Data::destroy));
         cache_.clear();
         index_by_id_.clear(); // no memory release since it just stores pointer and the according objects are in cache
+        index_by_CURRENCYID_CURRDATE_.clear();
     }
 
     /** Creates the database table if the table does not exist*/
@@ -213,6 +216,11 @@ struct DB_Table_CURRENCYHISTORY_V1 : public DB_Table
             return this->id() < r->id();
         }
 
+        mmDate CURRDATE_date() const
+        {
+            return mmDate::FromISO(CURRDATE);
+        }
+
         explicit Data(Self* table = 0) 
         {
             table_ = table;
@@ -425,7 +433,10 @@ struct DB_Table_CURRENCYHISTORY_V1 : public DB_Table
                 {
                     Self::Data* e = *it;
                     if (e->id() == entity->id()) 
+                    {
                         *e = *entity;  // in-place update
+                        index_keys(e);
+                    }
                 }
             }
         }
@@ -439,6 +450,7 @@ struct DB_Table_CURRENCYHISTORY_V1 : public DB_Table
         {
             entity->id((db->GetLastRowId()).ToLong());
             index_by_id_.insert(std::make_pair(entity->id(), entity));
+            index_keys(entity);
         }
         return true;
     }
@@ -510,6 +522,38 @@ struct DB_Table_CURRENCYHISTORY_V1 : public DB_Table
 
         return 0;
     }
+
+    /** Key of CURRENCYID, CURRDATE in index_by_CURRENCYID_CURRDATE_, case-insensitive like match() */
+    static std::wstring key_CURRENCYID_CURRDATE(int arg1, const wxString& arg2)
+    {
+        return std::to_wstring(arg1) + L"\t" + arg2.Lower().ToStdWstring();
+    }
+
+    /** Add the cached record to the natural key indexes */
+    void index_keys(const Self::Data* entity)
+    {
+        index_by_CURRENCYID_CURRDATE_[key_CURRENCYID_CURRDATE(entity->CURRENCYID, entity->CURRDATE)] = entity->id();
+    }
+
+    /** Return the cached record with the given CURRENCYID, CURRDATE through the index, without scanning the cache */
+    Self::Data* get_one(const Self::CURRENCYID& arg1, const Self::CURRDATE& arg2)
+    {
+        Index_By_Key::iterator it = index_by_CURRENCYID_CURRDATE_.find(key_CURRENCYID_CURRDATE(arg1.v_, arg2.v_));
+        if (it != index_by_CURRENCYID_CURRDATE_.end())
+        {
+            Index_By_Id::iterator entity = index_by_id_.find(it->second);
+            if (entity != index_by_id_.end() && match(entity->second, arg1, arg2))
+            {
+                ++ hit_;
+                return entity->second;
+            }
+            index_by_CURRENCYID_CURRDATE_.erase(it); // the record was removed or its key changed
+        }
+
+        ++ miss_;
+
+        return 0;
+    }
     
     /**
     * Search the memory table (Cache) for the data record.
@@ -544,6 +588,7 @@ struct DB_Table_CURRENCYHISTORY_V1 : public DB_Table
                 entity = new Self::Data(q, this);
                 cache_.push_back(entity);
                 index_by_id_.insert(std::make_pair(id, entity));
+                index_keys(entity);
             }
             stmt.Finalize();
         }
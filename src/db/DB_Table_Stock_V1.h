@@ -273,6 +273,11 @@ struct DB_Table_STOCK_V1 : public DB_Table
             return this->id() < r->id();
         }
 
+        mmDate PURCHASEDATE_date() const
+        {
+            return mmDate::FromISO(PURCHASEDATE);
+        }
+
         explicit Data(Self* table = 0) 
         {
             table_ = table;
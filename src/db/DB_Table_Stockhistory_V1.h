@@ -52,6 +52,8 @@ struct DB_Table_STOCKHISTORY_V1 : public DB_Table
     typedef std::map<int, Self::Data*> Index_By_Id;
     Cache cache_;
     Index_By_Id index_by_id_;
+    typedef std::unordered_map<std::wstring, int> Index_By_Key;
+    Index_By_Key index_by_SYMBOL_DATE_;
     Data* fake_; // in case the entity not found
 
     /** Destructor: clears any data records stored in memory */
@@ -67,6 +69,7 @@ struct DB_Table_STOCKHISTORY_V1 : public DB_Table
         std::for_each(cache_.begin(), cache_.end(), std::mem_fn(&Data::destroy));
         cache_.clear();
         index_by_id_.clear(); // no memory release since it just stores pointer and the according objects are in cache
+        index_by_SYMBOL_DATE_.clear();
     }
 
     /** Creates the database table if the table does not exist*/
@@ -213,6 +216,11 @@ struct DB_Table_STOCKHISTORY_V1 : public DB_Table
             return this->id() < r->id();
         }
 
+        mmDate DATE_date() const
+        {
+            return mmDate::FromISO(DATE);
+        }
+
         explicit Data(Self* table = 0) 
         {
             table_ = table;
@@ -424,7 +432,10 @@ struct DB_Table_STOCKHISTORY_V1 : public DB_Table
                 {
                     Self::Data* e = *it;
                     if (e->id() == entity->id()) 
+                    {
                         *e = *entity;  // in-place update
+                        index_keys(e);
+                    }
                 }
             }
         }
@@ -438,6 +449,7 @@ struct DB_Table_STOCKHISTORY_V1 : public DB_Table
         {
             entity->id((db->GetLastRowId()).ToLong());
             index_by_id_.insert(std::make_pair(entity->id(), entity));
+            index_keys(entity);
         }
         return true;
     }
@@ -509,6 +521,38 @@ struct DB_Table_STOCKHISTORY_V1 : public DB_Table
 
         return 0;
     }
+
+    /** Key of SYMBOL, DATE in index_by_SYMBOL_DATE_, case-insensitive like match() */
+    static std::wstring key_SYMBOL_DATE(const wxString& arg1, const wxString& arg2)
+    {
+        return arg1.Lower().ToStdWstring() + L"\t" + arg2.Lower().ToStdWstring();
+    }
+
+    /** Add the cached record to the natural key indexes */
+    void index_keys(const Self::Data* entity)
+    {
+        index_by_SYMBOL_DATE_[key_SYMBOL_DATE(entity->SYMBOL, entity->DATE)] = entity->id();
+    }
+
+    /** Return the cached record with the given SYMBOL, DATE through the index, without scanning the cache */
+    Self::Data* get_one(const Self::SYMBOL& arg1, const Self::DATE& arg2)
+    {
+        Index_By_Key::iterator it = index_by_SYMBOL_DATE_.find(key_SYMBOL_DATE(arg1.v_, arg2.v_));
+        if (it != index_by_SYMBOL_DATE_.end())
+        {
+            Index_By_Id::iterator entity = index_by_id_.find(it->second);
+            if (entity != index_by_id_.end() && match(entity->second, arg1, arg2))
+            {
+                ++ hit_;
+                return entity->second;
+            }
+            index_by_SYMBOL_DATE_.erase(it); // the record was removed or its key changed
+        }
+
+        ++ miss_;
+
+        return 0;
+    }
     
     /**
     * Search the memory table (Cache) for the data record.
@@ -543,6 +587,7 @@ struct DB_Table_STOCKHISTORY_V1 : public DB_Table
                 entity = new Self::Data(q, this);
                 cache_.push_back(entity);
                 index_by_id_.insert(std::make_pair(id, entity));
+                index_keys(entity);
             }
             stmt.Finalize();
         }
@@ -193,6 +193,11 @@ struct DB_Table_USAGE_V1 : public DB_Table
             return this->id() < r->id();
         }
 
+        mmDate USAGEDATE_date() const
+        {
+            return mmDate::FromISO(USAGEDATE);
+        }
+
         explicit Data(Self* table = 0) 
         {
             table_ = table;
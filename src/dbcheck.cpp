@@ -19,93 +19,278 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include "dbcheck.h"
 
-#include "model/Model_Account.h"
-#include "model/Model_Attachment.h"
-#include "model/Model_Billsdeposits.h"
-#include "model/Model_Category.h"
-#include "model/Model_Payee.h"
-#include "model/Model_Stock.h"
-
-bool dbCheck::checkDB()
+#include <algorithm>
+#include <atomic>
+#include <wx/intl.h>
+#include <wx/log.h>
+#include <wx/thread.h>
+#include <wx/wxsqlite3.h>
+
+/*
+    Each query returns the primary key of the rows breaking the rule. Rules are
+    ordered so that a repair which deletes parents runs before the rules on
+    their children; the repairs re-evaluate the query, so rows orphaned by an
+    earlier repair in the same run are picked up too.
+*/
+const std::vector<dbCheck::Rule>& dbCheck::rules()
 {
-    bool result = true;
-    result = checkAccounts();
-    
-    return result;
+    static const std::vector<Rule> RULES =
+    {
+        { "CHECKINGACCOUNT_V1", wxTRANSLATE("Transactions in a missing account"),
+            "SELECT c.TRANSID FROM CHECKINGACCOUNT_V1 c "
+            "LEFT JOIN ACCOUNTLIST_V1 a ON a.ACCOUNTID = c.ACCOUNTID WHERE a.ACCOUNTID IS NULL",
+            "DELETE FROM CHECKINGACCOUNT_V1 WHERE TRANSID IN (%s)" },
+        { "CHECKINGACCOUNT_V1", wxTRANSLATE("Transfers to a missing account"),
+            "SELECT c.TRANSID FROM CHECKINGACCOUNT_V1 c "
+            "LEFT JOIN ACCOUNTLIST_V1 a ON a.ACCOUNTID = c.TOACCOUNTID "
+            "WHERE c.TRANSCODE = 'Transfer' AND a.ACCOUNTID IS NULL",
+            "UPDATE CHECKINGACCOUNT_V1 SET TRANSCODE = 'Withdrawal', TOACCOUNTID = -1, TOTRANSAMOUNT = TRANSAMOUNT "
+            "WHERE TRANSID IN (%s)" },
+        { "CHECKINGACCOUNT_V1", wxTRANSLATE("Transactions with a missing payee"),
+            "SELECT c.TRANSID FROM CHECKINGACCOUNT_V1 c "
+            "LEFT JOIN PAYEE_V1 p ON p.PAYEEID = c.PAYEEID "
+            "WHERE c.TRANSCODE <> 'Transfer' AND p.PAYEEID IS NULL",
+            nullptr },
+        { "CHECKINGACCOUNT_V1", wxTRANSLATE("Transactions with a missing category"),
+            "SELECT c.TRANSID FROM CHECKINGACCOUNT_V1 c "
+            "LEFT JOIN CATEGORY_V1 g ON g.CATEGID = c.CATEGID "
+            "WHERE COALESCE(c.CATEGID, -1) <> -1 AND g.CATEGID IS NULL",
+            nullptr },
+        { "SPLITTRANSACTIONS_V1", wxTRANSLATE("Splits of a missing transaction"),
+            "SELECT s.SPLITTRANSID FROM SPLITTRANSACTIONS_V1 s "
+            "LEFT JOIN CHECKINGACCOUNT_V1 c ON c.TRANSID = s.TRANSID WHERE c.TRANSID IS NULL",
+            "DELETE FROM SPLITTRANSACTIONS_V1 WHERE SPLITTRANSID IN (%s)" },
+        { "ATTACHMENT_V1", wxTRANSLATE("Attachments of a missing transaction"),
+            "SELECT t.ATTACHMENTID FROM ATTACHMENT_V1 t "
+            "LEFT JOIN CHECKINGACCOUNT_V1 c ON c.TRANSID = t.REFID "
+            "WHERE t.REFTYPE = 'Transaction' AND c.TRANSID IS NULL",
+            "DELETE FROM ATTACHMENT_V1 WHERE ATTACHMENTID IN (%s)" },
+        { "CUSTOMFIELDDATA_V1", wxTRANSLATE("Custom field data of a missing transaction"),
+            "SELECT d.FIELDATADID FROM CUSTOMFIELDDATA_V1 d "
+            "JOIN CUSTOMFIELD_V1 f ON f.FIELDID = d.FIELDID AND f.REFTYPE = 'Transaction' "
+            "LEFT JOIN CHECKINGACCOUNT_V1 c ON c.TRANSID = d.REFID "
+            "WHERE d.REFID > 0 AND c.TRANSID IS NULL",
+            "DELETE FROM CUSTOMFIELDDATA_V1 WHERE FIELDATADID IN (%s)" },
+        { "SPLITTRANSACTIONS_V1", wxTRANSLATE("Splits with a missing category"),
+            "SELECT s.SPLITTRANSID FROM SPLITTRANSACTIONS_V1 s "
+            "LEFT JOIN CATEGORY_V1 g ON g.CATEGID = s.CATEGID WHERE g.CATEGID IS NULL",
+            nullptr },
+        { "CHECKINGACCOUNT_V1", wxTRANSLATE("Split transactions whose amount differs from the split total"),
+            "SELECT c.TRANSID FROM CHECKINGACCOUNT_V1 c "
+            "JOIN SPLITTRANSACTIONS_V1 s ON s.TRANSID = c.TRANSID "
+            "GROUP BY c.TRANSID HAVING ABS(ABS(c.TRANSAMOUNT) - ABS(TOTAL(s.SPLITTRANSAMOUNT))) > 0.005",
+            "UPDATE CHECKINGACCOUNT_V1 SET TRANSAMOUNT = "
+            "(SELECT ABS(TOTAL(s.SPLITTRANSAMOUNT)) FROM SPLITTRANSACTIONS_V1 s WHERE s.TRANSID = CHECKINGACCOUNT_V1.TRANSID), "
+            // a transfer keeps the rate between its two amounts
+            "TOTRANSAMOUNT = CASE WHEN TRANSCODE <> 'Transfer' THEN TOTRANSAMOUNT "
+            "WHEN TRANSAMOUNT = 0 OR TOTRANSAMOUNT = TRANSAMOUNT THEN "
+            "(SELECT ABS(TOTAL(s.SPLITTRANSAMOUNT)) FROM SPLITTRANSACTIONS_V1 s WHERE s.TRANSID = CHECKINGACCOUNT_V1.TRANSID) "
+            "ELSE TOTRANSAMOUNT / TRANSAMOUNT * "
+            "(SELECT ABS(TOTAL(s.SPLITTRANSAMOUNT)) FROM SPLITTRANSACTIONS_V1 s WHERE s.TRANSID = CHECKINGACCOUNT_V1.TRANSID) END "
+            "WHERE TRANSID IN (%s)" },
+        { "BILLSDEPOSITS_V1", wxTRANSLATE("Scheduled transactions in a missing account"),
+            "SELECT b.BDID FROM BILLSDEPOSITS_V1 b "
+            "LEFT JOIN ACCOUNTLIST_V1 a ON a.ACCOUNTID = b.ACCOUNTID WHERE a.ACCOUNTID IS NULL",
+            "DELETE FROM BILLSDEPOSITS_V1 WHERE BDID IN (%s)" },
+        { "BILLSDEPOSITS_V1", wxTRANSLATE("Scheduled transfers to a missing account"),
+            "SELECT b.BDID FROM BILLSDEPOSITS_V1 b "
+            "LEFT JOIN ACCOUNTLIST_V1 a ON a.ACCOUNTID = b.TOACCOUNTID "
+            "WHERE b.TRANSCODE = 'Transfer' AND a.ACCOUNTID IS NULL",
+            "UPDATE BILLSDEPOSITS_V1 SET TRANSCODE = 'Withdrawal', TOACCOUNTID = -1, TOTRANSAMOUNT = TRANSAMOUNT "
+            "WHERE BDID IN (%s)" },
+        { "BILLSDEPOSITS_V1", wxTRANSLATE("Scheduled transactions with a missing payee"),
+            "SELECT b.BDID FROM BILLSDEPOSITS_V1 b "
+            "LEFT JOIN PAYEE_V1 p ON p.PAYEEID = b.PAYEEID "
+            "WHERE b.TRANSCODE <> 'Transfer' AND p.PAYEEID IS NULL",
+            nullptr },
+        { "BUDGETSPLITTRANSACTIONS_V1", wxTRANSLATE("Splits of a missing scheduled transaction"),
+            "SELECT s.SPLITTRANSID FROM BUDGETSPLITTRANSACTIONS_V1 s "
+            "LEFT JOIN BILLSDEPOSITS_V1 b ON b.BDID = s.TRANSID WHERE b.BDID IS NULL",
+            "DELETE FROM BUDGETSPLITTRANSACTIONS_V1 WHERE SPLITTRANSID IN (%s)" },
+        { "PAYEE_V1", wxTRANSLATE("Payees with a missing default category"),
+            "SELECT p.PAYEEID FROM PAYEE_V1 p "
+            "LEFT JOIN CATEGORY_V1 g ON g.CATEGID = p.CATEGID "
+            "WHERE COALESCE(p.CATEGID, -1) <> -1 AND g.CATEGID IS NULL",
+            "UPDATE PAYEE_V1 SET CATEGID = -1 WHERE PAYEEID IN (%s)" },
+        { "CATEGORY_V1", wxTRANSLATE("Subcategories of a missing category"),
+            "SELECT g.CATEGID FROM CATEGORY_V1 g "
+            "LEFT JOIN CATEGORY_V1 p ON p.CATEGID = g.PARENTID "
+            "WHERE COALESCE(g.PARENTID, -1) <> -1 AND p.CATEGID IS NULL",
+            nullptr },
+        { "STOCK_V1", wxTRANSLATE("Stocks held in a missing or non investment account"),
+            "SELECT s.STOCKID FROM STOCK_V1 s "
+            "LEFT JOIN ACCOUNTLIST_V1 a ON a.ACCOUNTID = s.HELDAT "
+            "WHERE a.ACCOUNTID IS NULL OR a.ACCOUNTTYPE <> 'Investment'",
+            nullptr },
+        { "TRANSLINK_V1", wxTRANSLATE("Links from a missing transaction"),
+            "SELECT l.TRANSLINKID FROM TRANSLINK_V1 l "
+            "LEFT JOIN CHECKINGACCOUNT_V1 c ON c.TRANSID = l.CHECKINGACCOUNTID WHERE c.TRANSID IS NULL",
+            "DELETE FROM TRANSLINK_V1 WHERE TRANSLINKID IN (%s)" },
+        { "TRANSLINK_V1", wxTRANSLATE("Links to a missing asset or stock"),
+            "SELECT l.TRANSLINKID FROM TRANSLINK_V1 l "
+            "LEFT JOIN ASSETS_V1 a ON l.LINKTYPE = 'Asset' AND a.ASSETID = l.LINKRECORDID "
+            "LEFT JOIN STOCK_V1 s ON l.LINKTYPE = 'Stock' AND s.STOCKID = l.LINKRECORDID "
+            "WHERE a.ASSETID IS NULL AND s.STOCKID IS NULL",
+            "DELETE FROM TRANSLINK_V1 WHERE TRANSLINKID IN (%s)" },
+        { "SHAREINFO_V1", wxTRANSLATE("Share details of a missing transaction"),
+            "SELECT i.SHAREINFOID FROM SHAREINFO_V1 i "
+            "LEFT JOIN CHECKINGACCOUNT_V1 c ON c.TRANSID = i.CHECKINGACCOUNTID WHERE c.TRANSID IS NULL",
+            "DELETE FROM SHAREINFO_V1 WHERE SHAREINFOID IN (%s)" },
+        { "ACCOUNTLIST_V1", wxTRANSLATE("Accounts with a missing currency"),
+            "SELECT a.ACCOUNTID FROM ACCOUNTLIST_V1 a "
+            "LEFT JOIN CURRENCYFORMATS_V1 c ON c.CURRENCYID = a.CURRENCYID WHERE c.CURRENCYID IS NULL",
+            nullptr },
+        { "BUDGETTABLE_V1", wxTRANSLATE("Budget entries with a missing year or category"),
+            "SELECT b.BUDGETENTRYID FROM BUDGETTABLE_V1 b "
+            "LEFT JOIN BUDGETYEAR_V1 y ON y.BUDGETYEARID = b.BUDGETYEARID "
+            "LEFT JOIN CATEGORY_V1 g ON g.CATEGID = b.CATEGID "
+            "WHERE y.BUDGETYEARID IS NULL OR g.CATEGID IS NULL",
+            "DELETE FROM BUDGETTABLE_V1 WHERE BUDGETENTRYID IN (%s)" },
+    };
+    return RULES;
 }
 
-bool dbCheck::checkAccounts()
+namespace
 {
-    bool result = true;
-
-    // Transactions
-    const auto &transactions = Model_Checking::instance().all();
-    for (const auto& trx : transactions)
-        if (!Model_Account::instance().get(trx.ACCOUNTID) || (Model_Checking::type(trx) == Model_Checking::TRANSFER && !Model_Account::instance().get(trx.TOACCOUNTID)))
-        {
-            result = false;
-        }
+    class CheckThread : public wxThread
+    {
+    public:
+        CheckThread(const wxString& dbpath, const wxString& key
+            , std::vector<dbCheck::Result>& results, std::atomic<size_t>& next)
+            : wxThread(wxTHREAD_JOINABLE)
+            , m_dbpath(dbpath), m_key(key), m_results(results), m_next(next) {};
 
-    // BillsDeposits
-    const auto &bills = Model_Billsdeposits::instance().all();
-    for (const auto& bill : bills)
-        if (!Model_Account::instance().get(bill.ACCOUNTID) || (Model_Billsdeposits::type(bill) == Model_Billsdeposits::TRANSFER && !Model_Account::instance().get(bill.TOACCOUNTID)))
+    protected:
+        virtual ExitCode Entry()
         {
-            result = false;
-        }
+            wxSQLite3Database db;
+            wxString error;
+            try
+            {
+                db.Open(m_dbpath, m_key, WXSQLITE_OPEN_READONLY);
+                db.SetBusyTimeout(2000);
+            }
+            catch (const wxSQLite3Exception& e)
+            {
+                error = e.GetMessage();
+            }
 
-    // Stocks
-    const auto &stocks = Model_Stock::instance().all();
-    for (const auto& stock : stocks)
-        if (!Model_Account::instance().get(stock.HELDAT) || (Model_Account::type(Model_Account::instance().get(stock.HELDAT)) != Model_Account::INVESTMENT))
-        {
-            result = false;
+            // every thread owns the results it claims, no locking needed
+            for (size_t i = m_next++; i < m_results.size(); i = m_next++)
+            {
+                dbCheck::Result& result = m_results[i];
+                if (!error.empty())
+                {
+                    result.error = error;
+                    continue;
+                }
+                try
+                {
+                    wxSQLite3ResultSet q = db.ExecuteQuery(result.rule->query);
+                    while (q.NextRow())
+                        result.ids.push_back(q.GetInt64(0).GetValue());
+                }
+                catch (const wxSQLite3Exception& e)
+                {
+                    result.error = e.GetMessage();
+                }
+            }
+            if (db.IsOpen()) db.Close();
+            return nullptr;
         }
 
-    return result;
+    private:
+        wxString m_dbpath;
+        wxString m_key;
+        std::vector<dbCheck::Result>& m_results;
+        std::atomic<size_t>& m_next;
+    };
 }
 
-bool dbCheck::checkAttachments()
+std::vector<dbCheck::Result> dbCheck::checkDB(const wxString& dbpath, const wxString& key)
 {
-    return true;
-}
+    std::vector<Result> results;
+    for (const auto& rule : rules())
+        results.push_back({ &rule, {}, "" });
 
-bool dbCheck::checkBudgets()
-{
-    return true;
-}
+    std::atomic<size_t> next(0);
+    const size_t workers = std::min(results.size(), static_cast<size_t>(std::max(wxThread::GetCPUCount(), 1)));
+    std::vector<CheckThread*> threads;
+    for (size_t i = 0; i < workers; i++)
+    {
+        CheckThread* thread = new CheckThread(dbpath, key, results, next);
+        if (thread->Run() == wxTHREAD_NO_ERROR)
+            threads.push_back(thread);
+        else
+            delete thread;
+    }
+    for (auto thread : threads)
+    {
+        thread->Wait();
+        delete thread;
+    }
 
-bool dbCheck::checkBudgetYears()
-{
-    return true;
-}
+    if (threads.empty())
+    {
+        for (auto& result : results)
+            result.error = _("Unable to start the check");
+    }
 
-bool dbCheck::checkCategories()
-{
-    return true;
+    return results;
 }
 
-bool dbCheck::checkCurrencies()
+int dbCheck::repairDB(wxSQLite3Database* db, const std::vector<Result>& results)
 {
-    return true;
-}
-
-bool dbCheck::checkPayees()
-{
-    return true;
+    int changes = 0;
+    db->Savepoint("MMEX_Check");
+    try
+    {
+        for (const auto& result : results)
+        {
+            // Also the rules that passed the check: an earlier repair may have orphaned their rows
+            if (!result.rule->repair || !result.error.empty()) continue;
+            changes += db->ExecuteUpdate(wxString::Format(result.rule->repair, result.rule->query));
+        }
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogError("%s", e.GetMessage());
+        db->Rollback("MMEX_Check");
+        db->ReleaseSavepoint("MMEX_Check");
+        return -1;
+    }
+    db->ReleaseSavepoint("MMEX_Check");
+    return changes;
 }
 
-bool dbCheck::checkStocks()
+wxString dbCheck::report(const std::vector<Result>& results)
 {
-    return true;
-}
+    const size_t MAX_IDS = 20;
+    wxString out;
+    for (const auto& result : results)
+    {
+        if (!result.error.empty())
+        {
+            out << wxGetTranslation(result.rule->description) << ": " << result.error << "\n";
+            continue;
+        }
+        if (result.ids.empty()) continue;
 
-bool dbCheck::checkSubcategories()
-{
-    return true;
+        out << wxString::Format("%s (%s): %zu", wxGetTranslation(result.rule->description)
+            , result.rule->table, result.ids.size());
+        out << (result.rule->repair ? "" : wxString(" - ") + _("manual fix required")) << "\n    ";
+        for (size_t i = 0; i < result.ids.size() && i < MAX_IDS; i++)
+            out << (i ? ", " : "") << result.ids[i];
+        if (result.ids.size() > MAX_IDS) out << ", ...";
+        out << "\n";
+    }
+    return out;
 }
 
-bool dbCheck::checkTransactions()
+bool dbCheck::isRepairable(const std::vector<Result>& results)
 {
-    return true;
+    for (const auto& result : results)
+        if (!result.ids.empty() && result.rule->repair)
+            return true;
+    return false;
 }
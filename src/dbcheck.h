@@ -19,21 +19,40 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #ifndef MM_EX_DBCHECK_H_
 #define MM_EX_DBCHECK_H_
 
+#include <vector>
+#include <wx/string.h>
+
+class wxSQLite3Database;
+
 class dbCheck
 {
-    static bool  checkAccounts();
-    static bool  checkAttachments();
-    static bool  checkBudgets();
-    static bool  checkBudgetYears();
-    static bool  checkCategories();
-    static bool  checkCurrencies();
-    static bool  checkPayees();
-    static bool  checkStocks();
-    static bool  checkSubcategories();
-    static bool  checkTransactions();
-
 public:
-    static bool checkDB();
+    /* One integrity rule: an anti-join returning the ids of offending rows */
+    struct Rule
+    {
+        const char* table;
+        const char* description;
+        const char* query;
+        /* set-based fix taking the rule query as subquery, nullptr when it needs the user */
+        const char* repair;
+    };
+
+    struct Result
+    {
+        const Rule* rule;
+        std::vector<long long> ids;
+        wxString error;
+    };
+
+    static const std::vector<Rule>& rules();
+
+    /* Run every rule on its own read-only connection, rules are spread over worker threads */
+    static std::vector<Result> checkDB(const wxString& dbpath, const wxString& key);
+    /* Apply every repair in rule order in one savepoint, returns the number of rows changed */
+    static int repairDB(wxSQLite3Database* db, const std::vector<Result>& results);
+
+    static wxString report(const std::vector<Result>& results);
+    static bool isRepairable(const std::vector<Result>& results);
 };
 
-#endif // MM_EX_DBCHECK_H_
\ No newline at end of file
+#endif // MM_EX_DBCHECK_H_
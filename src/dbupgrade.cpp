@@ -21,13 +21,19 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include "dbupgrade.h"
 #include "constants.h"
 #include "util.h"
+#include "model/Model_Setting.h"
 
+#include <wx/dir.h>
 #include <wx/filedlg.h>
 #include <wx/filename.h>
 #include <wx/msgdlg.h>
+#include <wx/progdlg.h>
 #include <wx/textdlg.h>
 #include <wx/textfile.h>
 #include <wx/tokenzr.h>
+#include <wx/thread.h>
+#include <wx/wfstream.h>
+#include <wx/zstream.h>
 
 int dbUpgrade::GetCurrentVersion(wxSQLite3Database * db)
 {
@@ -56,125 +62,285 @@ std::vector<wxString> dbUpgrade::SplitQueries(const wxString & statement)
     return queries;
 }
 
-bool dbUpgrade::UpgradeToVersion(wxSQLite3Database * db, int version)
+bool dbUpgrade::InitializeVersion(wxSQLite3Database* db, int version)
+{
+    try
+    {
+        wxSQLite3Statement stmt = db->PrepareStatement(wxString::Format("PRAGMA user_version = %i", version));
+        stmt.ExecuteUpdate();
+        return true;
+    }
+    catch (const wxSQLite3Exception& /*e*/)
+    {
+        return false;
+    }
+}
+
+std::vector<std::pair<int, wxString>> dbUpgrade::UpgradePlan(int fromVersion)
 {
-    wxString UpgradeQueries = dbUpgradeQuery[version];
+    std::vector<std::pair<int, wxString>> plan;
+    for (int version = fromVersion + 1; version <= dbLatestVersion; version++)
+    {
+        for (const wxString& query : SplitQueries(dbUpgradeQuery[version]))
+            plan.emplace_back(version, query);
+    }
+    return plan;
+}
+
+bool dbUpgrade::UpgradeDB(wxSQLite3Database * db, const wxString& DbFileName, const wxString& key)
+{
+    int ver = GetCurrentVersion(db);
+
+    if (ver == -1 || ver > dbLatestVersion)
+    {
+        wxMessageBox(_("MMEX database error!") + "\n\n"
+            + wxString::Format(_("MMEX database version %i doesn't work with this MMEX version.\nPlease upgrade MMEX to newer version."), ver)
+            , _("MMEX database upgrade"), wxOK | wxICON_ERROR);
+        return false;
+    }
+
+    // One backup of the database as found, then every pending version in a
+    // single transaction: either the whole upgrade lands or none of it
+    if (!BackupDB(DbFileName, dbUpgrade::BACKUPTYPE::VERSION_UPGRADE, 999, ver, key, db)
+        && wxMessageBox(_("The backup of the database before the upgrade could not be written.") + "\n\n"
+            + _("Do you want to upgrade the database without a backup?")
+            , _("MMEX database upgrade"), wxYES_NO | wxNO_DEFAULT | wxICON_WARNING) != wxYES)
+    {
+        return false;
+    }
+
+    const auto plan = UpgradePlan(ver);
+    wxProgressDialog progressDlg(_("MMEX database upgrade"), wxEmptyString
+        , std::max(static_cast<int>(plan.size()), 1), nullptr
+        , wxPD_AUTO_HIDE | wxPD_APP_MODAL | wxPD_SMOOTH | wxPD_ELAPSED_TIME);
 
     db->Savepoint("MMEX_Upgrade");
-    for (const wxString& query : SplitQueries(UpgradeQueries))
+    // intermediate scripts may rebuild tables out of reference order,
+    // the constraints only have to hold when the upgrade commits
+    db->ExecuteUpdate("PRAGMA defer_foreign_keys = ON");
+
+    int step = 0;
+    for (const auto& item : plan)
     {
         try
         {
-            wxSQLite3Statement stmt = db->PrepareStatement(query);
+            wxSQLite3Statement stmt = db->PrepareStatement(item.second);
             stmt.ExecuteUpdate();
         }
         catch (const wxSQLite3Exception& e)
         {
-            wxMessageBox(wxString::Format(_("MMEX database upgrade to version %i failed!"), version) + "\n\n"
+            wxMessageBox(wxString::Format(_("MMEX database upgrade to version %i failed!"), item.first) + "\n\n"
                 + _("Please restore DB from autocreated pre-upgrade backup and retry or contact MMEX support") + "\n\n"
                 + e.GetMessage(), _("MMEX database upgrade"), wxOK | wxICON_ERROR);
             db->Rollback("MMEX_Upgrade");
+            db->ReleaseSavepoint("MMEX_Upgrade");
             return false;
         }
+        progressDlg.Update(++step, wxString::Format(_("Upgrading to version %i"), item.first));
     }
-    if (!InitializeVersion(db, version))
+
+    if (!InitializeVersion(db, dbLatestVersion))
+    {
+        db->Rollback("MMEX_Upgrade");
+        db->ReleaseSavepoint("MMEX_Upgrade");
         return false;
-    
+    }
     db->ReleaseSavepoint("MMEX_Upgrade");
-    return true;
-}
 
-bool dbUpgrade::InitializeVersion(wxSQLite3Database* db, int version)
-{
+    // the schema changed under the planner, refresh its statistics once
     try
     {
-        wxSQLite3Statement stmt = db->PrepareStatement(wxString::Format("PRAGMA user_version = %i", version));
-        stmt.ExecuteUpdate();
-        return true;
+        db->ExecuteUpdate("ANALYZE");
     }
-    catch (const wxSQLite3Exception& /*e*/)
+    catch (const wxSQLite3Exception& e)
     {
-        return false;
+        wxLogDebug("ANALYZE after upgrade: %s", e.GetMessage());
     }
+
+    wxMessageBox(wxString::Format(_("MMEX database succesfully upgraded to version %i"), dbLatestVersion) + "\n\n"
+        + _("We suggest a database optimization under Tools -> Database -> Optimize"), _("MMEX database upgrade"), wxOK | wxICON_INFORMATION);
+
+    return true;
 }
 
-bool dbUpgrade::UpgradeDB(wxSQLite3Database * db, const wxString& DbFileName)
+namespace
 {
-    int ver = GetCurrentVersion(db);
+    const int BACKUP_PAGES_PER_STEP = 1024;
 
-    if (ver == -1 || ver > dbLatestVersion)
+    // Copy a consistent snapshot of src into target, optionally gzip it, then
+    // move it into place so a backup file is never left half written.
+    bool WriteBackup(wxSQLite3Database& src, const wxString& target, const wxString& key, bool compress)
     {
-        wxMessageBox(_("MMEX database error!") + "\n\n"
-            + wxString::Format(_("MMEX database version %i doesn't work with this MMEX version.\nPlease upgrade MMEX to newer version."), ver)
-            , _("MMEX database upgrade"), wxOK | wxICON_ERROR);
-        return false;
+        const wxString tmpName = target + ".tmp";
+        try
+        {
+            src.SetBackupRestorePageCount(BACKUP_PAGES_PER_STEP);
+            src.Backup(compress ? tmpName + ".db" : tmpName, key);
+        }
+        catch (const wxSQLite3Exception& e)
+        {
+            wxLogError(_("Database backup %s failed: %s"), target, e.GetMessage());
+            wxRemoveFile(compress ? tmpName + ".db" : tmpName);
+            return false;
+        }
+
+        if (compress)
+        {
+            bool ok = false;
+            {
+                wxFileInputStream in(tmpName + ".db");
+                wxFileOutputStream out(tmpName);
+                if (in.IsOk() && out.IsOk())
+                {
+                    wxZlibOutputStream zout(out, wxZ_DEFAULT_COMPRESSION, wxZLIB_GZIP);
+                    zout.Write(in);
+                    ok = zout.Close() && out.Close();
+                }
+            }
+            wxRemoveFile(tmpName + ".db");
+            if (!ok)
+            {
+                wxLogError(_("Database backup %s failed: %s"), target, _("could not compress the file"));
+                wxRemoveFile(tmpName);
+                return false;
+            }
+        }
+
+        if (!wxRenameFile(tmpName, target, true))
+        {
+            wxLogError(_("Database backup %s failed: %s"), target, _("could not rename the temporary file"));
+            return false;
+        }
+        return true;
     }
 
-    for (; ver < dbLatestVersion; ver++)
+    void RemoveOldBackups(const wxString& FileName, const wxString& BackupName, int FilesToKeep)
     {
-        BackupDB(DbFileName, dbUpgrade::BACKUPTYPE::VERSION_UPGRADE, 999, ver);
-        if (!UpgradeToVersion(db, ver + 1))
-            return false;
+        // wxFindFirstFile keeps global state, wxDir is safe from the backup thread
+        const wxFileName fn(FileName);
+        const wxString fileSearch = wxString::Format("%s%s????-??-??.bak", fn.GetFullName(), BackupName);
+        wxArrayString files;
+        wxDir::GetAllFiles(fn.GetPath(), &files, fileSearch, wxDIR_FILES);
+        wxDir::GetAllFiles(fn.GetPath(), &files, fileSearch + ".gz", wxDIR_FILES);
+        files.Sort();
+
+        while (files.GetCount() > static_cast<size_t>(FilesToKeep))
+        {
+            wxFileName fnLastFile(files.Item(0));
+            wxLogDebug("%s", files.Item(0));
+            // ensure file is not read only before deleting file.
+            if (fnLastFile.IsFileWritable())
+                wxRemoveFile(files.Item(0));
+
+            files.RemoveAt(0);
+        }
     }
 
-    wxMessageBox(wxString::Format(_("MMEX database succesfully upgraded to version %i"), ver) + "\n\n"
-        + _("We suggest a database optimization under Tools -> Database -> Optimize"), _("MMEX database upgrade"), wxOK | wxICON_INFORMATION);
+    class BackupThread : public wxThread
+    {
+    public:
+        BackupThread(const wxString& source, const wxString& key, const wxString& target
+            , bool compress, const wxString& backupName, int filesToKeep)
+            : wxThread(wxTHREAD_JOINABLE)
+            , m_source(source), m_key(key), m_target(target)
+            , m_compress(compress), m_backupName(backupName), m_filesToKeep(filesToKeep), m_ok(false) {};
+
+        /* Whether the backup file was written, valid once the thread has been joined */
+        bool Succeeded() const { return m_ok; }
+
+    protected:
+        virtual ExitCode Entry()
+        {
+            // a private connection, so the backup only ever takes short read locks
+            // and restarts by itself if another connection writes in between steps
+            wxSQLite3Database db;
+            try
+            {
+                db.Open(m_source, m_key);
+                db.SetBusyTimeout(2000);
+            }
+            catch (const wxSQLite3Exception& e)
+            {
+                wxLogError(_("Database backup %s failed: %s"), m_target, e.GetMessage());
+                return nullptr;
+            }
 
-    return true;
+            m_ok = WriteBackup(db, m_target, m_key, m_compress);
+            if (m_ok && !m_backupName.empty())
+                RemoveOldBackups(m_source, m_backupName, m_filesToKeep);
+            db.Close();
+            return nullptr;
+        }
+
+    private:
+        wxString m_source;
+        wxString m_key;
+        wxString m_target;
+        bool m_compress;
+        wxString m_backupName;
+        int m_filesToKeep;
+        bool m_ok;
+    };
+
+    // joinable backup threads still owned by the main thread
+    std::vector<BackupThread*> g_backupThreads;
 }
 
-void dbUpgrade::BackupDB(const wxString& FileName, int BackupType, int FilesToKeep, int UpgradeVersion)
+bool dbUpgrade::BackupDB(const wxString& FileName, int BackupType, int FilesToKeep, int UpgradeVersion, const wxString& key, wxSQLite3Database* db)
 {
     wxFileName fn(FileName);
-    if (!fn.IsOk()) return;
+    if (!fn.IsOk()) return false;
 
+    const bool compress = Model_Setting::instance().GetBoolSetting("BACKUPDB_COMPRESS", false);
     const wxString BackupName[3] = { "_start_", "_update_", wxString::Format("_upgrade_v%i_", UpgradeVersion) };
-    const auto backupFileName = wxString::Format("%s%s%s.bak", FileName, BackupName[BackupType], wxDateTime().Today().FormatISODate());
+    const auto backupFileName = wxString::Format("%s%s%s.bak%s", FileName, BackupName[BackupType]
+        , wxDateTime().Today().FormatISODate(), compress ? ".gz" : "");
     wxFileName fnBak(backupFileName);
 
-    // process backup
-    switch (BackupType)
+    // START and VERSION_UPGRADE keep the first backup of the day
+    if (BackupType != BACKUPTYPE::CLOSE && fnBak.FileExists())
+        return true;
+
+    // Old backups are rotated after the new one is in place
+    const wxString rotate = (BackupType != BACKUPTYPE::VERSION_UPGRADE) ? BackupName[BackupType] : wxString("");
+
+    // During an upgrade the caller's connection is the source, which also sees
+    // pages still held in its WAL
+    if (db)
+        return WriteBackup(*db, backupFileName, key, compress);
+
+    BackupThread* thread = new BackupThread(FileName, key, backupFileName, compress, rotate, FilesToKeep);
+    if (thread->Run() != wxTHREAD_NO_ERROR)
     {
-    case BACKUPTYPE::START:
-        if (!fnBak.FileExists()) {
-            wxCopyFile(FileName, backupFileName, true);
-        }
-        break;
-    case BACKUPTYPE::CLOSE:
-        wxCopyFile(FileName, backupFileName, true);
-        break;
-    case BACKUPTYPE::VERSION_UPGRADE:
-        if (!fnBak.FileExists()) {
-            wxCopyFile(FileName, backupFileName, true);
-        }
-        break;
-    default:
-        break;
+        wxLogError(_("Database backup %s failed: %s"), backupFileName, _("could not start the backup thread"));
+        delete thread;
+        return false;
     }
 
-    // Cleanup old backups
-    if (BackupType != BACKUPTYPE::VERSION_UPGRADE)
+    // A close backup runs on behind the UI; a start backup must be taken
+    // before the database is opened and possibly upgraded
+    if (BackupType == BACKUPTYPE::CLOSE)
     {
-        wxSortedArrayString backupFileArray;
-        const auto fileSearch = wxString::Format("%s%s????-??-??.bak", FileName, BackupName[BackupType]);
-        wxString backupFile = wxFindFirstFile(fileSearch);
-        while (!backupFile.empty())
-        {
-            backupFileArray.Add(backupFile);
-            backupFile = wxFindNextFile();
-        }
+        g_backupThreads.push_back(thread);
+        return true;
+    }
 
-        while (backupFileArray.GetCount() > static_cast<size_t>(FilesToKeep))
-        {
-            wxFileName fnLastFile(backupFileArray.Item(0));
-            wxLogDebug("%s", backupFileArray.Item(0));
-            // ensure file is not read only before deleting file.
-            if (fnLastFile.IsFileWritable())
-                wxRemoveFile(backupFileArray.Item(0));
+    thread->Wait();
+    const bool ok = thread->Succeeded();
+    delete thread;
+    return ok;
+}
 
-            backupFileArray.erase(backupFileArray.begin());
-        }
+void dbUpgrade::WaitForBackups()
+{
+    for (auto thread : g_backupThreads)
+    {
+        thread->Wait();
+        delete thread;
     }
+    g_backupThreads.clear();
+    // show failures the threads logged before the application goes away
+    wxLog::FlushActive();
 }
 
 void dbUpgrade::SqlFileDebug(wxSQLite3Database * db)
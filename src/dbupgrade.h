@@ -30,12 +30,18 @@ class dbUpgrade
 {
     static int GetCurrentVersion(wxSQLite3Database * db);
     static std::vector<wxString> SplitQueries(const wxString& statement);
-    static bool UpgradeToVersion(wxSQLite3Database * db, int version);
+    /* every pending upgrade statement, tagged with the version it belongs to */
+    static std::vector<std::pair<int, wxString>> UpgradePlan(int fromVersion);
 public:
     static bool InitializeVersion(wxSQLite3Database* db, int version = dbLatestVersion);
     static bool isUpgradeDBrequired(wxSQLite3Database* db);
-    static bool UpgradeDB(wxSQLite3Database* db, const wxString& DbFileName);
-    static void BackupDB(const wxString& Filename, int BackupType, int FilesToKeep, int UpgradeVersion = 0);
+    static bool UpgradeDB(wxSQLite3Database* db, const wxString& DbFileName, const wxString& key = "");
+    /* Online backup through the SQLite backup API; CLOSE backups finish on a worker thread.
+       Returns false when the backup could not be written, failures are reported with wxLogError. */
+    static bool BackupDB(const wxString& Filename, int BackupType, int FilesToKeep, int UpgradeVersion = 0
+        , const wxString& key = "", wxSQLite3Database* db = nullptr);
+    /* Join close backups still running, called once before the application exits */
+    static void WaitForBackups();
     enum BACKUPTYPE { START = 0, CLOSE, VERSION_UPGRADE };
     static void SqlFileDebug(wxSQLite3Database * db);
 };
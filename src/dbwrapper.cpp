@@ -20,6 +20,8 @@
 #include "util.h"
 #include "paths.h"
 #include "constants.h"
+#include "option.h"
+#include <wx/filename.h>
 //----------------------------------------------------------------------------
 #include "sqlite3mc_amalgamation.h"
 //----------------------------------------------------------------------------
@@ -62,6 +64,10 @@ wxSharedPtr<wxSQLite3Database> mmDBWrapper::Open(const wxString &dbpath, const w
         //timeout 2 sec
         db->SetBusyTimeout(2000);
 
+        // without the profile the journal mode stored in the file is left as it is
+        if (Option::instance().getDatabasePerformanceProfile())
+            SetPerformanceProfile(db.get(), dbpath);
+
         return (db);
     }
     db->Close();
@@ -90,3 +96,69 @@ wxSharedPtr<wxSQLite3Database> mmDBWrapper::Open(const wxString &dbpath, const w
 
 //----------------------------------------------------------------------------
 
+
+void mmDBWrapper::SetPerformanceProfile(wxSQLite3Database* db, const wxString &dbpath)
+{
+    // page cache in KiB when negative, mmap capped so a 32-bit build keeps its address space
+    const int cache_kib = 64 * 1024;
+    const wxULongLong mmap_limit = wxULongLong(0, 512 * 1024 * 1024);
+
+    wxULongLong mmap_size = wxFileName::GetSize(dbpath);
+    if (mmap_size == wxInvalidSize || mmap_size > mmap_limit)
+        mmap_size = mmap_limit;
+
+    try
+    {
+        // journal_mode returns the mode actually set; WAL is refused on
+        // read-only media and some network shares, keep whatever SQLite chose
+        wxSQLite3ResultSet q = db->ExecuteQuery("PRAGMA journal_mode=WAL;");
+        const wxString mode = q.NextRow() ? q.GetAsString(0) : wxString("");
+        q.Finalize();
+
+        if (mode.CmpNoCase("wal") == 0)
+            db->ExecuteUpdate("PRAGMA synchronous=NORMAL;");
+        db->ExecuteUpdate(wxString::Format("PRAGMA cache_size=-%i;", cache_kib));
+        db->ExecuteUpdate("PRAGMA temp_store=MEMORY;");
+
+        // mmap reads bypass the sqlite3mc codec, it stays off for encrypted files
+        if (!db->IsEncrypted())
+        {
+            q = db->ExecuteQuery(wxString::Format("PRAGMA mmap_size=%s;", mmap_size.ToString()));
+            q.Finalize();
+        }
+        wxLogDebug("Database profile: journal %s, cache %i KiB, mmap %s", mode, cache_kib
+            , db->IsEncrypted() ? wxString("off") : mmap_size.ToString());
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogDebug("Database profile: %s", e.GetMessage());
+    }
+}
+
+void mmDBWrapper::ClearPerformanceProfile(wxSQLite3Database* db)
+{
+    try
+    {
+        // WAL is persistent in the file, go back to a rollback journal
+        // so the file is safe again on shares without shared memory
+        db->ExecuteQuery("PRAGMA journal_mode=DELETE;").Finalize();
+        db->ExecuteUpdate("PRAGMA synchronous=FULL;");
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogError("Database profile: %s", e.GetMessage());
+    }
+}
+
+void mmDBWrapper::ReKey(wxSQLite3Database* db, const wxString &key)
+{
+    wxSQLite3ResultSet q = db->ExecuteQuery("PRAGMA journal_mode;");
+    const bool wal = q.NextRow() && q.GetAsString(0).CmpNoCase("wal") == 0;
+    q.Finalize();
+
+    if (wal)
+        db->ExecuteQuery("PRAGMA journal_mode=DELETE;").Finalize();
+    db->ReKey(key);
+    if (wal)
+        db->ExecuteQuery("PRAGMA journal_mode=WAL;").Finalize();
+}
@@ -30,6 +30,13 @@ namespace mmDBWrapper
 
     wxSharedPtr<wxSQLite3Database> Open(const wxString &dbpath, const wxString &key = "");
 
+    /* Apply journal, cache and mmap pragmas sized to the database file */
+    void SetPerformanceProfile(wxSQLite3Database* db, const wxString &dbpath);
+    /* Return the open database from WAL to a rollback journal when the profile is turned off */
+    void ClearPerformanceProfile(wxSQLite3Database* db);
+    /* Rekey needs a rollback journal; switch out of WAL around the call */
+    void ReKey(wxSQLite3Database* db, const wxString &key);
+
 } // namespace mmDBWrapper
 
 //----------------------------------------------------------------------------
@@ -21,15 +21,18 @@ Copyright (C) 2021 Mark Whalley (mark@ipx.co.uk)
 #include "option.h"
 #include "paths.h"
 #include "diagnostics.h"
+#include "mmTrace.h"
 #include "util.h"
 #include "model/Model_Setting.h"
 #include "reports/htmlbuilder.h"
 #include <wx/display.h>
+#include <wx/ffile.h>
 
 wxIMPLEMENT_DYNAMIC_CLASS(mmDiagnosticsDialog, wxDialog);
 
 wxBEGIN_EVENT_TABLE(mmDiagnosticsDialog, wxDialog)
 EVT_BUTTON(wxID_OK, mmDiagnosticsDialog::OnOk)
+EVT_BUTTON(wxID_SAVE, mmDiagnosticsDialog::OnExportTrace)
 wxEND_EVENT_TABLE()
 
 const char HTMLPANEL[] = R"(<!DOCTYPE html>
@@ -85,6 +88,9 @@ void mmDiagnosticsDialog::CreateControls()
     bSizer0->Add(bSizer01, g_flagsExpand);
 
     wxBoxSizer* bSizer02 = new wxBoxSizer(wxHORIZONTAL);
+    wxButton* exportButton = new wxButton(this, wxID_SAVE, _("Export Trace..."));
+    exportButton->SetToolTip(_("Save the recorded timings in Chrome trace format"));
+    bSizer02->Add(exportButton, 0, wxALL, 5);
     m_okButton = new wxButton(this, wxID_OK, _("Close"));
     bSizer02->Add(m_okButton, 0, wxALL, 5);
     bSizer0->Add(bSizer02, g_flagsCenter);
@@ -141,6 +147,23 @@ void mmDiagnosticsDialog::RefreshView()
         , m_is_max ? "true" : "false");
     html << "</p>";
 
+    // Slowest paths recorded by mmTrace since startup
+    static const size_t MAX_TIMINGS = 25;
+    const auto stats = mmTrace::Stats(mmTrace::Snapshot());
+    html << "<p>";
+    html << "Timings (ms, slowest total first)";
+    html << "</p>";
+    html << "<table border='1' cellspacing='0' cellpadding='2'>";
+    html << "<tr><th>name</th><th>count</th><th>p50</th><th>p95</th><th>max</th><th>total</th></tr>";
+    for (size_t i = 0; i < stats.size() && i < MAX_TIMINGS; i++)
+    {
+        const auto& stat = stats[i];
+        html << wxString::Format("<tr><td>%s</td><td align='right'>%i</td><td align='right'>%.2f</td><td align='right'>%.2f</td>"
+            "<td align='right'>%.2f</td><td align='right'>%.1f</td></tr>"
+            , stat.name, static_cast<int>(stat.count), stat.p50, stat.p95, stat.max, stat.total);
+    }
+    html << "</table>";
+
     mmHTMLBuilder hb;
     hb.init(true);
     const wxString displayHtml = wxString::Format(HTMLPANEL, html);
@@ -153,3 +176,15 @@ void mmDiagnosticsDialog::OnOk(wxCommandEvent& event)
 {
     EndModal(wxID_OK);
 }
+
+void mmDiagnosticsDialog::OnExportTrace(wxCommandEvent& WXUNUSED(event))
+{
+    const wxString fileName = wxFileSelector(_("Export Trace")
+        , wxEmptyString, "mmex_trace.json", "json", "JSON (*.json)|*.json"
+        , wxFD_SAVE | wxFD_OVERWRITE_PROMPT, this);
+    if (fileName.empty()) return;
+
+    wxFFile file(fileName, "w");
+    if (!file.IsOpened() || !file.Write(mmTrace::ChromeTrace(mmTrace::Snapshot()), wxConvUTF8))
+        wxMessageBox(_("Unable to write file."), _("Export Trace"), wxOK | wxICON_ERROR, this);
+}
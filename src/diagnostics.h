@@ -46,6 +46,7 @@ private:
     void RefreshView();
  
     void OnOk(wxCommandEvent& event);
+    void OnExportTrace(wxCommandEvent& event);
 };
 
 #endif // MM_EX_DIAGNOSTICS_H_
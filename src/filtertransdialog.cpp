@@ -1110,29 +1110,16 @@ bool mmFilterTransactionsDialog::mmIsStatusMatches(const wxString& itemStatus) c
 
 bool mmFilterTransactionsDialog::mmIsTypeMaches(const wxString& typeState, int accountid, int toaccountid) const
 {
-    bool result = false;
-    if (typeState == Model_Checking::all_type()[Model_Checking::TRANSFER]
-        && cbTypeTransferTo_->GetValue()
-        && (!mmIsAccountChecked() || (m_selected_accounts_id.Index(accountid) != wxNOT_FOUND)))
-    {
-        result = true;
-    }
-    else if (typeState == Model_Checking::all_type()[Model_Checking::TRANSFER]
-        && cbTypeTransferFrom_->GetValue()
-        && (!mmIsAccountChecked() || (m_selected_accounts_id.Index(toaccountid) != wxNOT_FOUND)))
-    {
-        result = true;
-    }
-    else if (typeState == Model_Checking::all_type()[Model_Checking::WITHDRAWAL] && cbTypeWithdrawal_->IsChecked())
-    {
-        result = true;
-    }
-    else if (typeState == Model_Checking::all_type()[Model_Checking::DEPOSIT] && cbTypeDeposit_->IsChecked())
-    {
-        result = true;
-    }
-
-    return result;
+    if (typeState == Model_Checking::TRANSFER_STR)
+        return (cbTypeTransferTo_->GetValue()
+                && (!mmIsAccountChecked() || (m_selected_accounts_id.Index(accountid) != wxNOT_FOUND)))
+            || (cbTypeTransferFrom_->GetValue()
+                && (!mmIsAccountChecked() || (m_selected_accounts_id.Index(toaccountid) != wxNOT_FOUND)));
+    if (typeState == Model_Checking::WITHDRAWAL_STR)
+        return cbTypeWithdrawal_->IsChecked();
+    if (typeState == Model_Checking::DEPOSIT_STR)
+        return cbTypeDeposit_->IsChecked();
+    return false;
 }
 
 double mmFilterTransactionsDialog::mmGetAmountMin() const
@@ -219,6 +219,7 @@ wxBEGIN_EVENT_TABLE(mmGeneralReportManager, wxDialog)
     EVT_BUTTON(wxID_EXECUTE, mmGeneralReportManager::OnRun)
     EVT_BUTTON(wxID_CLOSE, mmGeneralReportManager::OnClose)
     EVT_BUTTON(ID_TEST, mmGeneralReportManager::OnSqlTest)
+    EVT_BUTTON(ID_PROFILE, mmGeneralReportManager::OnSqlProfile)
     EVT_BUTTON(wxID_NEW, mmGeneralReportManager::OnNewTemplate)
     //EVT_TREE_END_LABEL_EDIT(ID_REPORT_LIST, mmGeneralReportManager::OnLabelChanged)
     EVT_TREE_SEL_CHANGED(ID_REPORT_LIST, mmGeneralReportManager::OnSelChanged)
@@ -242,6 +243,7 @@ mmGeneralReportManager::mmGeneralReportManager(wxWindow* parent, wxSQLite3Databa
     , m_treeCtrl(nullptr)
     , m_dbView(nullptr)
     , m_sqlListBox(nullptr)
+    , m_sqlProfile(nullptr)
     , m_selectedReportID(0)
 {
     this->SetFont(parent->GetFont());
@@ -493,18 +495,27 @@ void mmGeneralReportManager::createEditorTab(wxNotebook* editors_notebook, int t
 
         wxBoxSizer *box_sizer2 = new wxBoxSizer(wxHORIZONTAL);
         wxButton* buttonPlay = new wxButton(pnl2, ID_TEST, _("&Test"));
+        wxButton* buttonProfile = new wxButton(pnl2, ID_PROFILE, _("&Profile"));
+        mmToolTip(buttonProfile, _("Measure the query and show its query plan"));
         wxButton* buttonNewTemplate = new wxButton(pnl2, wxID_NEW, _("Create Template"));
         wxStaticText *info = new wxStaticText(pnl2, wxID_INFO, "");
         buttonNewTemplate->Enable(false);
         box_sizer2->Add(buttonPlay);
         box_sizer2->AddSpacer(10);
+        box_sizer2->Add(buttonProfile);
+        box_sizer2->AddSpacer(10);
         box_sizer2->Add(buttonNewTemplate);
         box_sizer2->AddSpacer(10);
         box_sizer2->Add(info, g_flagsExpand);
 
-        m_sqlListBox = new sqlListCtrl(this, pnl2, wxID_ANY);
+        wxNotebook* result_notebook = new wxNotebook(pnl2, wxID_ANY);
+        m_sqlListBox = new sqlListCtrl(this, result_notebook, wxID_ANY);
+        result_notebook->AddPage(m_sqlListBox, _("Result"));
+        m_sqlProfile = new wxTextCtrl(result_notebook, wxID_ANY, ""
+            , wxDefaultPosition, wxDefaultSize, wxTE_MULTILINE | wxTE_READONLY | wxTE_DONTWRAP);
+        result_notebook->AddPage(m_sqlProfile, _("Profile"));
         bSizerp2->Add(box_sizer2);
-        bSizerp2->Add(m_sqlListBox, g_flagsExpand);
+        bSizerp2->Add(result_notebook, g_flagsExpand);
         bSizerp2->SetMinSize(wxSize(-1, 100));
 
         // Populate database view
@@ -576,6 +587,58 @@ void mmGeneralReportManager::OnSqlTest(wxCommandEvent& WXUNUSED(event))
     }
 }
 
+void mmGeneralReportManager::OnSqlProfile(wxCommandEvent& WXUNUSED(event))
+{
+    MinimalEditor* sqlText = wxDynamicCast(FindWindow(ID_SQL_CONTENT), MinimalEditor);
+    wxStaticText* info = wxDynamicCast(FindWindow(wxID_INFO), wxStaticText);
+    if (!sqlText || !m_sqlProfile) return;
+
+    const wxString sql = sqlText->GetStringSelection().empty() ? sqlText->GetValue() : sqlText->GetStringSelection();
+
+    wxBusyCursor wait;
+    Model_Report::SqlProfile profile;
+    wxString SqlError;
+    if (!Model_Report::instance().profile_sql(sql, profile, SqlError))
+    {
+        info->SetLabelText(_("SQL Syntax Error") + " (" + SqlError + ")");
+        return;
+    }
+
+    wxString out;
+    out << wxString::Format(_("Prepare: %.3f ms"), profile.prepare_ms) << "\n"
+        << wxString::Format(_("Step: %.3f ms"), profile.step_ms) << "\n"
+        << wxString::Format(_("Total: %.3f ms"), profile.total_ms) << "\n"
+        << wxString::Format(_("Rows returned: %zu"), profile.rows_returned) << "\n"
+        << wxString::Format(_("Rows scanned (full scan steps): %d"), profile.fullscan_steps) << "\n"
+        << wxString::Format(_("Sort operations: %d"), profile.sort_ops) << "\n"
+        << wxString::Format(_("Automatic indexes: %d"), profile.auto_indexes) << "\n"
+        << wxString::Format(_("Virtual machine steps: %d"), profile.vm_steps) << "\n\n";
+
+    out << _("Query plan:") << "\n";
+    for (const auto& step : profile.plan)
+        out << wxString(' ', 2 * (step.first + 1)) << "- " << step.second << "\n";
+
+    if (!profile.suggestions.empty())
+    {
+        out << "\n" << _("Suggestions:") << "\n";
+        for (const auto& hint : profile.suggestions)
+            out << "  * " << hint << "\n";
+    }
+
+    if (m_selectedReportID > 0)
+    {
+        Model_Report::instance().save_profile(m_selectedReportID, profile);
+        out << "\n" << _("History:") << "\n";
+        for (const auto& entry : Model_Report::instance().profile_history(m_selectedReportID))
+            out << "  " << entry << "\n";
+    }
+
+    m_sqlProfile->ChangeValue(out);
+    wxNotebook* result_notebook = wxDynamicCast(m_sqlProfile->GetParent(), wxNotebook);
+    if (result_notebook) result_notebook->SetSelection(1);
+    info->SetLabelText(wxString::Format(_("Profile: %.3f ms"), profile.total_ms));
+}
+
 void mmGeneralReportManager::OnNewTemplate(wxCommandEvent& WXUNUSED(event))
 {
     MinimalEditor* templateText = static_cast<MinimalEditor*>(FindWindow(ID_TEMPLATE));
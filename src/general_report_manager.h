@@ -78,6 +78,7 @@ private:
     void OnRun(wxCommandEvent& event);
     void OnClose(wxCommandEvent& event);
     void OnSqlTest(wxCommandEvent& event);
+    void OnSqlProfile(wxCommandEvent& event);
     void OnNewTemplate(wxCommandEvent& event);
     void OnItemRightClick(wxTreeEvent& event);
     void OnSelChanged(wxTreeEvent& event);
@@ -112,6 +113,7 @@ private:
     wxTreeCtrl* m_treeCtrl;
     wxTreeCtrl *m_dbView;
     sqlListCtrl* m_sqlListBox;
+    wxTextCtrl* m_sqlProfile;
     wxTreeItemId m_rootItem;
     wxTreeItemId m_selectedItemID;
     int m_selectedReportID;
@@ -139,6 +141,7 @@ private:
         ID_NOTEBOOK,
         ID_TYPELABEL,
         ID_TEST,
+        ID_PROFILE,
         ID_SQL_CONTENT,
         ID_LUA_CONTENT,
         ID_TEMPLATE,
@@ -190,6 +190,10 @@ Document metaData_doc;
 
 // Using SVG and wxBitmapBundle for better HiDPI support.
 static wxSharedPtr<wxBitmapBundle> programIconBundles[numSizes][MAX_PNG];
+// SVG source of each icon as read from the theme. Bundles are only
+// built from it on first use in mmBitmapBundle, so that loading a theme
+// does not parse every icon for every size before the first frame.
+static wxMemoryBuffer programIconSVG[MAX_PNG];
 
 static wxSharedPtr<wxArrayString> filesInVFS;
 
@@ -282,11 +286,11 @@ bool processThemes(wxString themeDir, wxString myTheme, bool metaPhase)
         const wxString thisTheme = themeFile.GetName();
         wxLogDebug ("Found theme [%s]", thisTheme);
 
-        wxFileInputStream themeZip(themeFile.GetFullPath());
-        wxASSERT(themeZip.IsOk());   // Make sure we can open find the Zip
-
         if (!thisTheme.Cmp(myTheme))
         {
+            wxFileInputStream themeZip(themeFile.GetFullPath());
+            wxASSERT(themeZip.IsOk());   // Make sure we can open find the Zip
+
             themeMatched = true;
             wxZipInputStream themeStream(themeZip);
             std::unique_ptr<wxZipEntry> themeEntry;
@@ -372,24 +376,18 @@ bool processThemes(wxString themeDir, wxString myTheme, bool metaPhase)
                     continue;
                 }
 
-                // So we have an icon file now, now need to convert from SVG to PNG at various resolutions and store
-                // it away for use
+                // So we have an icon file now, keep the SVG source, the conversion
+                // to the various resolutions is done on first use
 
                 wxMemoryOutputStream memOut(nullptr);
                 themeStream.Read(memOut);
                 const wxStreamBuffer* buffer = memOut.GetOutputStreamBuffer();
 
                 int svgEnum = iconName2enum.find(fileName)->second.first;
-                for(const auto &sizePair : sizes)
-                {
-                    const unsigned int icon_size = sizePair.second;
-                    programIconBundles[sizePair.first][svgEnum] = new wxBitmapBundle(
-                                         wxBitmapBundle::FromSVG(
-                                               static_cast<wxByte*>(buffer->GetBufferStart()), buffer->GetBufferSize(),
-                                                                    wxSize( icon_size, icon_size )
-                                                                )
-                                                  );
-                }
+                programIconSVG[svgEnum].SetDataLen(0);
+                programIconSVG[svgEnum].AppendData(buffer->GetBufferStart(), buffer->GetBufferSize());
+                for (const auto &sizePair : sizes)
+                    programIconBundles[sizePair.first][svgEnum].reset();
             }
         }
         cont = directory.GetNext(&filename);
@@ -432,7 +430,7 @@ bool checkThemeContents(wxArrayString *filesinTheme)
     int erroredIcons = 0;
     for (int i = 0; i < MAX_PNG; i++)
     {
-        if (!programIconBundles[0][i])
+        if (programIconSVG[i].IsEmpty())
         {
             for (auto it = iconName2enum.begin(); it != iconName2enum.end(); it++)
             {
@@ -510,6 +508,8 @@ void CloseTheme()
     for (int i = 0; i < numSizes; i++) 
         for (int j = 0; j < MAX_PNG; j++)
             programIconBundles[i][j].reset();
+    for (int j = 0; j < MAX_PNG; j++)
+        programIconSVG[j].Clear();
 }
 
 const wxString mmThemeMetaString(int ref)
@@ -588,5 +588,13 @@ const std::vector<wxColour> mmThemeMetaColourArray(int ref)
 const wxBitmapBundle mmBitmapBundle(const int ref, const int defSize)
 {
     const int idx = getIconSizeIdx(defSize);
-    return *programIconBundles[idx][ref];
+    auto& bundle = programIconBundles[idx][ref];
+    if (!bundle)
+    {
+        const wxMemoryBuffer& svg = programIconSVG[ref];
+        const int icon_size = sizes[idx].second;
+        bundle = new wxBitmapBundle(wxBitmapBundle::FromSVG(
+            static_cast<const wxByte*>(svg.GetData()), svg.GetDataLen(), wxSize(icon_size, icon_size)));
+    }
+    return *bundle;
 }
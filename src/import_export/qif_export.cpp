@@ -22,6 +22,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "paths.h"
 #include "export.h"
 #include "mmSimpleDialogs.h"
+#include "mmTrace.h"
 #include "option.h"
 #include "model/Model_Infotable.h"
 #include "model/Model_Account.h"
@@ -404,6 +405,7 @@ void mmQIFExportDialog::OnFileNameEntered(wxCommandEvent& event)
 
 void mmQIFExportDialog::mmExportQIF()
 {
+    mmTrace::Scope trace("QIF export");
     bool write_to_file = toFileCheckBox_->IsChecked();
     wxString fileName = m_text_ctrl_->GetValue();
 
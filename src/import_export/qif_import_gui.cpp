@@ -22,6 +22,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "export.h"
 #include "constants.h"
 #include "mmSimpleDialogs.h"
+#include "mmTrace.h"
 #include "paths.h"
 #include "util.h"
 #include "webapp.h"
@@ -382,6 +383,7 @@ void mmQIFImportDialog::fillControls()
 
 bool mmQIFImportDialog::mmReadQIFFile()
 {
+    mmTrace::Scope trace("QIF read");
     size_t numLines = 0;
     vQIF_trxs_.clear();
     m_QIFaccounts.clear();
@@ -871,6 +873,7 @@ void mmQIFImportDialog::OnAccountChanged(wxCommandEvent& event)
 
 void mmQIFImportDialog::OnOk(wxCommandEvent& WXUNUSED(event))
 {
+    mmTrace::Scope trace("QIF import");
     if (m_QIFaccounts.empty() && m_accountNameStr.empty() && !accountCheckBox_->IsChecked()) {
         return mmErrorDialogs::InvalidAccount(accountDropDown_);
     }
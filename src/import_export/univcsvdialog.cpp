@@ -25,6 +25,7 @@
 #include "images_list.h"
 #include "constants.h"
 #include "mmSimpleDialogs.h"
+#include "mmTrace.h"
 #include "paths.h"
 #include "platfdep.h"
 #include "util.h"
@@ -914,6 +915,7 @@ bool mmUnivCSVDialog::validateData(tran_holder & holder)
 
 void mmUnivCSVDialog::OnImport(wxCommandEvent& WXUNUSED(event))
 {
+    mmTrace::Scope trace("CSV import");
     // date and amount are required
     bool datefield = isIndexPresent(UNIV_CSV_DATE);
     bool amountfields = isIndexPresent(UNIV_CSV_AMOUNT)
@@ -1117,6 +1119,7 @@ void mmUnivCSVDialog::OnImport(wxCommandEvent& WXUNUSED(event))
 
 void mmUnivCSVDialog::OnExport(wxCommandEvent& WXUNUSED(event))
 {
+    mmTrace::Scope trace("CSV export");
     // date and amount are required
     if (!isIndexPresent(UNIV_CSV_DATE) || (!isIndexPresent(UNIV_CSV_AMOUNT)
         && (!isIndexPresent(UNIV_CSV_WITHDRAWAL) || !isIndexPresent(UNIV_CSV_DEPOSIT))))
@@ -25,12 +25,14 @@
 #include "mmSimpleDialogs.h"
 #include "mmTextCtrl.h"
 #include "paths.h"
+#include "quotes.h"
 #include "util.h"
 #include "validators.h"
 #include "model/allmodel.h"
 #include <rapidjson/rapidjson.h>
 #include <rapidjson/document.h>
 
+#include <algorithm>
 #include <vector>
 #include <wx/sstream.h>
 #include <wx/xml/xml.h>
@@ -486,6 +488,7 @@ void mmMainCurrencyDialog::OnOnlineUpdateCurRate(wxCommandEvent& /*event*/)
 {
     if (!m_static_dialog)    //Abort when trying to set base currency
     {
+        mmQuoteService::instance().ClearCache();
         OnlineUpdateCurRate(-1, false);
     }
 }
@@ -504,6 +507,7 @@ void mmMainCurrencyDialog::OnMenuSelected(wxCommandEvent& event)
             ShowCurrencyHistory();
             break;
         case MENU_ITEM2:
+            mmQuoteService::instance().ClearCache();
             OnlineUpdateCurRate(m_currency_id, false);
             break;
         case wxID_EDIT:
@@ -662,10 +666,10 @@ void mmMainCurrencyDialog::OnHistoryUpdate(wxCommandEvent& WXUNUSED(event))
     bool isCheckDate = msgResult == wxNO;
 
     wxString msg;
-    const std::map<wxDateTime, int> DatesList = Model_Currency::DateUsed(m_currency_id);
+    const std::vector<mmDate> DatesList = Model_Currency::DateUsed(m_currency_id);
     wxDateTime begin_date = wxDateTime::Now().Subtract(wxDateSpan::Years(1));
     if (isCheckDate && !DatesList.empty()) {
-        begin_date = DatesList.begin()->first;
+        begin_date = DatesList.front().ToDateTime();
     }
     wxLogDebug("Begin Date: %s", begin_date.FormatISODate());
 
@@ -691,28 +695,20 @@ void mmMainCurrencyDialog::OnHistoryUpdate(wxCommandEvent& WXUNUSED(event))
     bool isFound = !historical_rates.empty();
     if (isFound)
     {
-        Model_CurrencyHistory::instance().Savepoint();
-        if (isCheckDate)
+        Model_CurrencyHistory::Data_Set rates;
+        for (const auto& entry : historical_rates)
         {
-            for (const auto entry : DatesList)
-            {
-                wxLogDebug("%s %s", entry.first.FormatISODate(), entry.first.FormatISOTime());
-                if (historical_rates.find(entry.first) != historical_rates.end())
-                {
-                    const wxDate date = entry.first;
-                    wxLogDebug("%s", date.FormatISODate());
-                    Model_CurrencyHistory::instance().addUpdate(m_currency_id, date, historical_rates[date], Model_CurrencyHistory::ONLINE);
-                }
-            }
-        }
-        else
-        {
-            for (auto &entry : historical_rates)
-            {
-                Model_CurrencyHistory::instance().addUpdate(m_currency_id, entry.first, entry.second, Model_CurrencyHistory::ONLINE);
-            }
+            if (isCheckDate && !std::binary_search(DatesList.begin(), DatesList.end(), mmDate(entry.first)))
+                continue;
+
+            Model_CurrencyHistory::Data rate;
+            rate.CURRENCYID = m_currency_id;
+            rate.CURRDATE = entry.first.FormatISODate();
+            rate.CURRVALUE = entry.second;
+            rate.CURRUPDTYPE = Model_CurrencyHistory::ONLINE;
+            rates.push_back(rate);
         }
-        Model_CurrencyHistory::instance().ReleaseSavepoint();
+        Model_CurrencyHistory::instance().addUpdate(rates);
 
         fillControls();
         ShowCurrencyHistory();
@@ -738,12 +734,10 @@ void mmMainCurrencyDialog::OnHistoryDeleteUnused(wxCommandEvent& WXUNUSED(event)
         }
         else
         {
-            std::map<wxDateTime, int> DatesList = Model_Currency::DateUsed(currency.CURRENCYID);
-            wxDateTime CurrDate;
+            const std::vector<mmDate> DatesList = Model_Currency::DateUsed(currency.CURRENCYID);
             for (const auto& r : Model_CurrencyHistory::instance().find(Model_CurrencyHistory::CURRENCYID(currency.CURRENCYID)))
             {
-                CurrDate.ParseDate(r.CURRDATE);
-                if (DatesList.find(CurrDate) == DatesList.end())
+                if (!std::binary_search(DatesList.begin(), DatesList.end(), r.CURRDATE_date()))
                     Model_CurrencyHistory::instance().remove(r.id());
             }
         }
@@ -884,7 +878,7 @@ bool mmMainCurrencyDialog::GetOnlineHistory(const wxString &symbol, wxDateTime b
     );
 
     wxString json_data;
-    auto err_code = http_get_data(URL, json_data);
+    auto err_code = mmQuoteService::instance().get(URL, json_data);
     if (err_code != CURLE_OK) {
         msg = json_data;
         return false;
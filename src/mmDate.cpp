@@ -0,0 +1,56 @@
+/*******************************************************
+ Copyright (C) 2026 MoneyManagerEx contributors
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmDate.h"
+
+mmDate::mmDate(const wxDateTime& date)
+    : m_days(date.IsValid()
+        ? mmDate(date.GetDay(), date.GetMonth(), date.GetYear()).m_days
+        : INVALID)
+{
+}
+
+mmDate mmDate::Today()
+{
+    return mmDate(wxDateTime::Today());
+}
+
+wxDateTime mmDate::ToDateTime() const
+{
+    if (!IsValid()) return wxInvalidDateTime;
+    return wxDateTime(static_cast<wxDateTime::wxDateTime_t>(GetDay()), GetMonth(), GetYear());
+}
+
+wxString mmDate::FormatISODate() const
+{
+    if (!IsValid()) return wxEmptyString;
+
+    const int year = GetYear();
+    if (year < 0 || year > 9999)
+        return ToDateTime().FormatISODate();
+
+    const int month = GetMonth() + 1;
+    const int day = GetDay();
+    const char iso[] = {
+        static_cast<char>('0' + year / 1000), static_cast<char>('0' + year / 100 % 10)
+        , static_cast<char>('0' + year / 10 % 10), static_cast<char>('0' + year % 10)
+        , '-', static_cast<char>('0' + month / 10), static_cast<char>('0' + month % 10)
+        , '-', static_cast<char>('0' + day / 10), static_cast<char>('0' + day % 10)
+    };
+    return wxString::FromAscii(iso, sizeof(iso));
+}
@@ -0,0 +1,140 @@
+/*******************************************************
+ Copyright (C) 2026 MoneyManagerEx contributors
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#pragma once
+
+#include <wx/datetime.h>
+#include <wx/string.h>
+#include <cstdint>
+
+/*
+A calendar date stored as the number of days since 1970-01-01 in the
+proleptic Gregorian calendar. Reading one from the ISO "YYYY-MM-DD" strings
+of the database takes a few integer operations, so loops over many rows
+compare and bucket dates without going through wxDateTime.
+
+    if (tran.TRANSDATE_date() <= account->STATEMENTDATE_date()) ...
+
+Month numbers follow wxDateTime: wxDateTime::Jan is 0.
+*/
+class mmDate
+{
+public:
+    /** An invalid date */
+    constexpr mmDate() : m_days(INVALID) {}
+    constexpr explicit mmDate(int32_t days) : m_days(days) {}
+    constexpr mmDate(int day, wxDateTime::Month month, int year)
+        : m_days(from_civil(year - (month < wxDateTime::Mar ? 1 : 0), month + 1, day)) {}
+    /** The calendar date of a wxDateTime, whatever its time */
+    explicit mmDate(const wxDateTime& date);
+
+    /**
+    Parse "YYYY-MM-DD", anything after the date such as a time is ignored.
+    * Returns an invalid date when the string does not start with a valid date.
+    */
+    static mmDate FromISO(const wxString& iso);
+    static mmDate Today();
+
+    constexpr bool IsValid() const { return m_days != INVALID; }
+    /** Days since 1970-01-01 */
+    constexpr int32_t GetValue() const { return m_days; }
+
+    constexpr int GetYear() const { return year_of(m_days + EPOCH); }
+    constexpr wxDateTime::Month GetMonth() const { return static_cast<wxDateTime::Month>(month_of(m_days + EPOCH) - 1); }
+    constexpr int GetDay() const { return day_of(doe_of(m_days + EPOCH)); }
+
+    /** Midnight local time of the date, or wxInvalidDateTime */
+    wxDateTime ToDateTime() const;
+    /** "YYYY-MM-DD", or an empty string for an invalid date */
+    wxString FormatISODate() const;
+
+    static constexpr bool IsLeapYear(int year)
+    {
+        return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+    }
+    /** month is 1 to 12 */
+    static constexpr int DaysInMonth(int year, int month)
+    {
+        return month == 2 ? (IsLeapYear(year) ? 29 : 28) : 30 + ((month + month / 8) & 1);
+    }
+
+    constexpr mmDate operator+(int days) const { return mmDate(m_days + days); }
+    constexpr mmDate operator-(int days) const { return mmDate(m_days - days); }
+    constexpr int operator-(const mmDate& r) const { return m_days - r.m_days; }
+
+    constexpr bool operator==(const mmDate& r) const { return m_days == r.m_days; }
+    constexpr bool operator!=(const mmDate& r) const { return m_days != r.m_days; }
+    constexpr bool operator<(const mmDate& r) const { return m_days < r.m_days; }
+    constexpr bool operator<=(const mmDate& r) const { return m_days <= r.m_days; }
+    constexpr bool operator>(const mmDate& r) const { return m_days > r.m_days; }
+    constexpr bool operator>=(const mmDate& r) const { return m_days >= r.m_days; }
+
+private:
+    static const int32_t INVALID = INT32_MIN;
+    /* Days from 0000-03-01 to 1970-01-01 */
+    static const int32_t EPOCH = 719468;
+
+    /*
+    Civil date conversions after H. Hinnant, "chrono-Compatible Low-Level Date Algorithms".
+    Years start on March 1st so the leap day is the last day of the year, and are
+    grouped into eras of 400 years. y is the year counted that way, m is 1 to 12.
+    */
+    static constexpr int32_t era_of_year(int y) { return (y >= 0 ? y : y - 399) / 400; }
+    static constexpr int32_t from_civil(int y, int m, int d)
+    {
+        return era_of_year(y) * 146097 + doe_of_civil(y - era_of_year(y) * 400, m, d) - EPOCH;
+    }
+    static constexpr int32_t doe_of_civil(int yoe, int m, int d)
+    {
+        return yoe * 365 + yoe / 4 - yoe / 100 + (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    }
+
+    /* z is the day counted from 0000-03-01 */
+    static constexpr int32_t era_of(int32_t z) { return (z >= 0 ? z : z - 146096) / 146097; }
+    static constexpr int32_t doe_of(int32_t z) { return z - era_of(z) * 146097; }
+    static constexpr int32_t yoe_of(int32_t doe) { return (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365; }
+    static constexpr int32_t doy_of(int32_t doe) { return doe - (365 * yoe_of(doe) + yoe_of(doe) / 4 - yoe_of(doe) / 100); }
+    static constexpr int32_t mp_of(int32_t doe) { return (5 * doy_of(doe) + 2) / 153; }
+    static constexpr int day_of(int32_t doe) { return doy_of(doe) - (153 * mp_of(doe) + 2) / 5 + 1; }
+    static constexpr int month_of(int32_t z) { return mp_of(doe_of(z)) < 10 ? mp_of(doe_of(z)) + 3 : mp_of(doe_of(z)) - 9; }
+    static constexpr int year_of(int32_t z) { return yoe_of(doe_of(z)) + era_of(z) * 400 + (month_of(z) <= 2 ? 1 : 0); }
+
+    int32_t m_days;
+};
+
+inline mmDate mmDate::FromISO(const wxString& iso)
+{
+    static const size_t DIGITS[] = { 0, 1, 2, 3, 5, 6, 8, 9 };
+    if (iso.length() < 10 || iso[4] != '-' || iso[7] != '-')
+        return mmDate();
+
+    int n[8];
+    for (int i = 0; i < 8; i++)
+    {
+        const wxUniChar c = iso[DIGITS[i]];
+        if (c < '0' || c > '9') return mmDate();
+        n[i] = static_cast<int>(c.GetValue()) - '0';
+    }
+
+    const int year = n[0] * 1000 + n[1] * 100 + n[2] * 10 + n[3];
+    const int month = n[4] * 10 + n[5];
+    const int day = n[6] * 10 + n[7];
+    if (month < 1 || month > 12 || day < 1 || day > DaysInMonth(year, month))
+        return mmDate();
+    return mmDate(day, static_cast<wxDateTime::Month>(month - 1), year);
+}
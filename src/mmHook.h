@@ -17,6 +17,7 @@
  ********************************************************/
 #pragma once
 #include "option.h"
+#include "autocomplete.h"
 
 class CommitCallbackHook : public wxSQLite3Hook
 {
@@ -49,6 +50,7 @@ public:
             break;
         }
         wxLogDebug("database: %s, table: %s, rowid: %lld", database, table, rowid);
+        mmAutoComplete::instance().OnRowChanged(table, rowid.GetValue(), type == SQLITE_DELETE);
 
         // TODO sync search index from full text search
     }
@@ -19,6 +19,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 ********************************************************/
 
 #include "mmSimpleDialogs.h"
+#include "autocomplete.h"
 #include "constants.h"
 #include "images_list.h"
 #include "mmex.h"
@@ -29,6 +30,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "model/Model_Setting.h"
 
 #include <wx/richtooltip.h>
+#include <wx/textcompleter.h>
 
 //------- Pop-up calendar, currently only used for MacOS only
 // See: https://github.com/moneymanagerex/moneymanagerex/issues/3139
@@ -97,6 +99,27 @@ void mmCalendarPopup::OnEndSelection(wxCalendarEvent& event)
 
 //------------
 
+namespace
+{
+    // Completes the typed prefix from the shared index, most used names first,
+    // limited to the names the combo box offers
+    class mmUsageCompleter : public wxTextCompleterSimple
+    {
+    public:
+        mmUsageCompleter(mmAutoComplete::KIND kind, const std::map<wxString, int>& allowed)
+            : m_kind(kind), m_allowed(allowed) {}
+
+        virtual void GetCompletions(const wxString& prefix, wxArrayString& res)
+        {
+            res = mmAutoComplete::instance().Complete(m_kind, prefix, m_allowed);
+        }
+
+    private:
+        mmAutoComplete::KIND m_kind;
+        const std::map<wxString, int>& m_allowed; // owned by the combo box, which owns the completer
+    };
+}
+
 wxBEGIN_EVENT_TABLE(mmComboBox, wxComboBox)
 EVT_SET_FOCUS(mmComboBox::OnSetFocus)
 EVT_COMBOBOX_DROPDOWN(wxID_ANY, mmComboBox::OnDropDown)
@@ -105,6 +128,7 @@ wxEND_EVENT_TABLE()
 
 mmComboBox::mmComboBox(wxWindow* parent, wxWindowID id, wxSize size)
     : wxComboBox(parent, id, "", wxDefaultPosition, size)
+    , completion_kind_(-1)
     , is_initialized_(false)
 {
     Bind(wxEVT_CHAR_HOOK, &mmComboBox::OnKeyPressed, this);
@@ -121,13 +145,20 @@ void mmComboBox::OnSetFocus(wxFocusEvent& event)
 {
     if (!is_initialized_)
     {
-       wxArrayString auto_complete;
-       for (const auto& item : all_elements_) {
-           auto_complete.Add(item.first);
+       wxArrayString auto_complete = sorted_elements_;
+       if (auto_complete.size() != all_elements_.size())
+       {
+           auto_complete.Clear();
+           for (const auto& item : all_elements_) {
+               auto_complete.Add(item.first);
+           }
+           auto_complete.Sort(CaseInsensitiveLocaleCmp);
        }
-       auto_complete.Sort(CaseInsensitiveLocaleCmp);
 
-       this->AutoComplete(auto_complete);
+       // the completer is not supported everywhere (macOS), fall back to the list
+       if (completion_kind_ < 0
+           || !this->AutoComplete(new mmUsageCompleter(static_cast<mmAutoComplete::KIND>(completion_kind_), all_elements_)))
+           this->AutoComplete(auto_complete);
        if (!auto_complete.empty()) {
            this->Insert(auto_complete, 0);
        }
@@ -257,7 +288,7 @@ bool mmComboBox::mmIsValid() const
 
 void mmComboBoxAccount::init()
 {
-    all_elements_ = Model_Account::instance().all_accounts(excludeClosed_);
+    mmAutoComplete::instance().Fill(mmAutoComplete::ACCOUNT, excludeClosed_, all_elements_, sorted_elements_);
     if (accountID_ > -1)
         all_elements_[Model_Account::get_account_name(accountID_)] = accountID_;
 }
@@ -270,6 +301,7 @@ mmComboBoxAccount::mmComboBoxAccount(wxWindow* parent, wxWindowID id
     , excludeClosed_(excludeClosed)
     , accountID_(accountID)
 {
+    completion_kind_ = mmAutoComplete::ACCOUNT;
     init();
 }
 
@@ -277,7 +309,7 @@ mmComboBoxAccount::mmComboBoxAccount(wxWindow* parent, wxWindowID id
 
 void mmComboBoxPayee::init()
 {
-    all_elements_ = Model_Payee::instance().all_payees(excludeHidden_);
+    mmAutoComplete::instance().Fill(mmAutoComplete::PAYEE, excludeHidden_, all_elements_, sorted_elements_);
     if (payeeID_ > -1)
         all_elements_[Model_Payee::get_payee_name(payeeID_)] = payeeID_;
 }
@@ -290,6 +322,7 @@ mmComboBoxPayee::mmComboBoxPayee(wxWindow* parent, wxWindowID id
     , excludeHidden_(excludeHidden)
     , payeeID_(payeeID)
 {
+    completion_kind_ = mmAutoComplete::PAYEE;
     init();
 }
 
@@ -322,7 +355,7 @@ void mmComboBoxCategory::init()
 {
     int i = 0;
     all_elements_.clear();
-    all_categories_ = Model_Category::instance().all_categories(excludeHidden_);
+    mmAutoComplete::instance().Fill(mmAutoComplete::CATEGORY, excludeHidden_, all_categories_, sorted_elements_);
     if (catID_ > -1)
         all_categories_.insert(std::make_pair(Model_Category::full_name(catID_)
                                     , catID_));
@@ -340,6 +373,7 @@ mmComboBoxCategory::mmComboBoxCategory(wxWindow* parent, wxWindowID id
     , excludeHidden_(excludeHidden)
     , catID_(catID)
 {
+    completion_kind_ = mmAutoComplete::CATEGORY;
     init();
 }
 
@@ -54,6 +54,10 @@ protected:
     void OnKeyPressed(wxKeyEvent& event);
     virtual void init() = 0;
     std::map<wxString, int> all_elements_;
+    // display order when init() already has it, saves sorting on focus
+    wxArrayString sorted_elements_;
+    // mmAutoComplete::KIND completing the typed prefix by use, -1 for the plain list
+    int completion_kind_;
 private:
     bool is_initialized_;
     wxDECLARE_EVENT_TABLE();
@@ -0,0 +1,198 @@
+/*******************************************************
+ Copyright (C) 2026 MoneyManagerEx contributors
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmTrace.h"
+#include "db/DB_Table.h"
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace
+{
+    const size_t RING_SIZE = 4096; // power of two
+
+    /* seq is odd while the owning thread writes the slot,
+       the payload is atomic too so a reader racing the writer only sees a torn copy that seq rejects */
+    struct Slot
+    {
+        std::atomic<unsigned> seq{ 0 };
+        std::atomic<const char*> name{ nullptr };
+        std::atomic<long long> start{ 0 };
+        std::atomic<long long> duration{ 0 };
+    };
+
+    struct Ring
+    {
+        Slot slots[RING_SIZE];
+        std::atomic<unsigned long long> head{ 0 };
+        std::atomic<bool> in_use{ true };
+        unsigned thread = 0;
+    };
+
+    // guards ring registration and snapshots, never Record()
+    std::mutex g_rings_mutex;
+    std::vector<Ring*> g_rings;
+    const mmTrace::clock::time_point g_epoch = mmTrace::clock::now();
+
+    /* Hands the ring back for reuse when its thread exits */
+    struct RingOwner
+    {
+        Ring* ring = nullptr;
+        ~RingOwner() { if (ring) ring->in_use.store(false, std::memory_order_release); }
+    };
+    thread_local RingOwner t_owner;
+
+    Ring* ThisRing()
+    {
+        if (t_owner.ring) return t_owner.ring;
+
+        std::lock_guard<std::mutex> lock(g_rings_mutex);
+        for (Ring* ring : g_rings)
+        {
+            bool expected = false;
+            if (ring->in_use.compare_exchange_strong(expected, true))
+                return t_owner.ring = ring;
+        }
+        Ring* ring = new Ring;
+        ring->thread = static_cast<unsigned>(g_rings.size()) + 1;
+        g_rings.push_back(ring);
+        return t_owner.ring = ring;
+    }
+
+    long long Micro(mmTrace::clock::duration d)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+    }
+}
+
+long mmTrace::Scope::elapsed() const
+{
+    return static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - m_start).count());
+}
+
+void mmTrace::Record(const char* name, clock::time_point start, clock::time_point end)
+{
+    Ring* ring = ThisRing();
+    const unsigned long long n = ring->head.load(std::memory_order_relaxed);
+    Slot& slot = ring->slots[n & (RING_SIZE - 1)];
+
+    const unsigned seq = slot.seq.load(std::memory_order_relaxed);
+    slot.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start.store(Micro(start - g_epoch), std::memory_order_relaxed);
+    slot.duration.store(Micro(end - start), std::memory_order_relaxed);
+    slot.seq.store(seq + 2, std::memory_order_release);
+    ring->head.store(n + 1, std::memory_order_release);
+}
+
+const char* mmTrace::Intern(const wxString& name)
+{
+    static std::mutex mutex;
+    static std::set<std::string> names;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return names.insert(std::string(name.utf8_str())).first->c_str();
+}
+
+std::vector<mmTrace::Event> mmTrace::Snapshot()
+{
+    std::vector<Event> events;
+    std::lock_guard<std::mutex> lock(g_rings_mutex);
+    for (const Ring* ring : g_rings)
+    {
+        const unsigned long long head = ring->head.load(std::memory_order_acquire);
+        for (unsigned long long i = head > RING_SIZE ? head - RING_SIZE : 0; i < head; i++)
+        {
+            const Slot& slot = ring->slots[i & (RING_SIZE - 1)];
+            const unsigned seq = slot.seq.load(std::memory_order_acquire);
+            if (seq & 1) continue;
+            Event e = { slot.name.load(std::memory_order_relaxed)
+                , slot.start.load(std::memory_order_relaxed)
+                , slot.duration.load(std::memory_order_relaxed)
+                , ring->thread };
+            std::atomic_thread_fence(std::memory_order_acquire);
+            // skip slots the owner rewrote while they were being copied
+            if (slot.seq.load(std::memory_order_relaxed) != seq || !e.name) continue;
+            events.push_back(e);
+        }
+    }
+    return events;
+}
+
+std::vector<mmTrace::Stat> mmTrace::Stats(const std::vector<Event>& events)
+{
+    std::map<std::string, std::vector<long long> > durations;
+    for (const auto& e : events)
+        durations[e.name].push_back(e.duration);
+
+    std::vector<Stat> stats;
+    for (auto& item : durations)
+    {
+        std::vector<long long>& d = item.second;
+        std::sort(d.begin(), d.end());
+        Stat stat;
+        stat.name = wxString::FromUTF8(item.first.c_str());
+        stat.count = d.size();
+        stat.p50 = d[(d.size() - 1) / 2] / 1000.0;
+        stat.p95 = d[(d.size() - 1) * 95 / 100] / 1000.0;
+        stat.max = d.back() / 1000.0;
+        stat.total = 0;
+        for (const auto us : d) stat.total += us / 1000.0;
+        stats.push_back(stat);
+    }
+    std::sort(stats.begin(), stats.end(), [](const Stat& x, const Stat& y) { return x.total > y.total; });
+    return stats;
+}
+
+wxString mmTrace::ChromeTrace(const std::vector<Event>& events)
+{
+    StringBuffer json_buffer;
+    Writer<StringBuffer> json_writer(json_buffer);
+    json_writer.StartObject();
+    json_writer.Key("displayTimeUnit");
+    json_writer.String("ms");
+    json_writer.Key("traceEvents");
+    json_writer.StartArray();
+    for (const auto& e : events)
+    {
+        json_writer.StartObject();
+        json_writer.Key("name");
+        json_writer.String(e.name);
+        json_writer.Key("cat");
+        json_writer.String("mmex");
+        json_writer.Key("ph");
+        json_writer.String("X");
+        json_writer.Key("ts");
+        json_writer.Int64(e.start);
+        json_writer.Key("dur");
+        json_writer.Int64(e.duration);
+        json_writer.Key("pid");
+        json_writer.Int(1);
+        json_writer.Key("tid");
+        json_writer.Uint(e.thread);
+        json_writer.EndObject();
+    }
+    json_writer.EndArray();
+    json_writer.EndObject();
+
+    return wxString::FromUTF8(json_buffer.GetString());
+}
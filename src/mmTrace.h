@@ -0,0 +1,78 @@
+/*******************************************************
+ Copyright (C) 2026 MoneyManagerEx contributors
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#pragma once
+
+#include <wx/string.h>
+#include <chrono>
+#include <vector>
+
+/*
+Scoped timers for the hot paths, shown in the Diagnostics dialog.
+Every thread appends to its own fixed-size ring of recent events, so
+recording takes no lock; the dialog reads a snapshot of all rings.
+
+    mmTrace::Scope trace("filterTable");
+*/
+class mmTrace
+{
+public:
+    typedef std::chrono::steady_clock clock;
+
+    struct Event
+    {
+        const char* name;
+        long long start;    // microseconds since startup
+        long long duration; // microseconds
+        unsigned thread;
+    };
+
+    struct Stat
+    {
+        wxString name;
+        size_t count;
+        double p50, p95, max, total; // milliseconds
+    };
+
+    class Scope
+    {
+    public:
+        explicit Scope(const char* name) : m_name(name), m_start(clock::now()) {}
+        ~Scope() { Record(m_name, m_start, clock::now()); }
+        /* Milliseconds since construction */
+        long elapsed() const;
+
+    private:
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        const char* m_name;
+        clock::time_point m_start;
+    };
+
+    /* name must stay valid for the program lifetime: a literal or the result of Intern() */
+    static void Record(const char* name, clock::time_point start, clock::time_point end);
+    /* Return a stable copy of a runtime name */
+    static const char* Intern(const wxString& name);
+
+    /* Events still held in the rings, oldest first per thread */
+    static std::vector<Event> Snapshot();
+    /* Latency percentiles per name, slowest total first */
+    static std::vector<Stat> Stats(const std::vector<Event>& events);
+    /* Chrome trace event format, for chrome://tracing or Perfetto */
+    static wxString ChromeTrace(const std::vector<Event>& events);
+};
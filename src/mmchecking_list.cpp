@@ -41,6 +41,7 @@
 
 #include <wx/srchctrl.h>
 #include <algorithm>
+#include <limits>
 #include <wx/sound.h>
 
 //----------------------------------------------------------------------------
@@ -90,121 +91,103 @@ TransactionListCtrl::EColumn TransactionListCtrl::toEColumn(const unsigned long
         return res;
 }
 
-void TransactionListCtrl::SortTransactions(int sortcol, bool ascend)
+namespace
 {
-    const auto& ref_type = Model_Attachment::reftype_desc(Model_Attachment::TRANSACTION);
-    Model_CustomField::FIELDTYPE type;
+    /* Value of a transaction in one sort column, numeric columns set number and the others text */
+    struct SortKey
+    {
+        double number;
+        std::wstring text;
+    };
 
-    switch (m_real_columns[sortcol])
+    int Compare(const SortKey& x, const SortKey& y)
     {
-    case TransactionListCtrl::COL_ID:
-        ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterByTRANSID())
-              : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), SorterByTRANSID());
-        break;
-    case TransactionListCtrl::COL_NUMBER:
-        ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), Model_Checking::SorterByNUMBER())
-              : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), Model_Checking::SorterByNUMBER());
-        break;
-    case TransactionListCtrl::COL_ACCOUNT:
-        ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterByACCOUNTNAME())
-              : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), SorterByACCOUNTNAME());
-        break;
-    case TransactionListCtrl::COL_PAYEE_STR:
-        ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterByPAYEENAME())
-              : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), SorterByPAYEENAME());
-        break;
-    case TransactionListCtrl::COL_STATUS:
-        ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterBySTATUS())
-              : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), SorterBySTATUS());
-        break;
-    case TransactionListCtrl::COL_CATEGORY:
-        ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterByCATEGNAME())
-              : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), SorterByCATEGNAME());
-        break;
-    case TransactionListCtrl::COL_WITHDRAWAL:
-        ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), Model_Checking::SorterByWITHDRAWAL())
-              : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), Model_Checking::SorterByWITHDRAWAL());
-        break;
-    case TransactionListCtrl::COL_DEPOSIT:
-        ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), Model_Checking::SorterByDEPOSIT())
-              : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), Model_Checking::SorterByDEPOSIT());
-        break;
-    case TransactionListCtrl::COL_BALANCE:
-        ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), Model_Checking::SorterByBALANCE())
-              : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), Model_Checking::SorterByBALANCE());
-        break;
-    case TransactionListCtrl::COL_CREDIT:
-        ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), Model_Checking::SorterByBALANCE())
-              : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), Model_Checking::SorterByBALANCE());
-        break;
-    case TransactionListCtrl::COL_NOTES:
-        ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterByNOTES())
-              : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), SorterByNOTES());
-        break;
-    case TransactionListCtrl::COL_DATE:
-        ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterByTRANSDATE())
-              : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), SorterByTRANSDATE());
-        break;
-    case TransactionListCtrl::COL_DELETEDTIME:
-        ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterByDELETEDTIME())
-            : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), SorterByDELETEDTIME());
-        break;
-    case TransactionListCtrl::COL_UDFC01:
-        type = Model_CustomField::getUDFCType(ref_type, "UDFC01");
-        if (type == Model_CustomField::FIELDTYPE::DECIMAL || type == Model_CustomField::FIELDTYPE::INTEGER)
-            ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterByUDFC01_val)
-                  : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), SorterByUDFC01_val);
-        else
-            ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterByUDFC01)
-                  : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), SorterByUDFC01);
-        break;
-    case TransactionListCtrl::COL_UDFC02:
-        type = Model_CustomField::getUDFCType(ref_type, "UDFC02");
-        if (type == Model_CustomField::FIELDTYPE::DECIMAL || type == Model_CustomField::FIELDTYPE::INTEGER)
-            ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterByUDFC02_val)
-                  : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), SorterByUDFC02_val);
-        else
-            ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterByUDFC02)
-                  : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), SorterByUDFC02);
-        break;
-    case TransactionListCtrl::COL_UDFC03:
-        type = Model_CustomField::getUDFCType(ref_type, "UDFC03");
-        if (type == Model_CustomField::FIELDTYPE::DECIMAL || type == Model_CustomField::FIELDTYPE::INTEGER)
-            ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterByUDFC03_val)
-                  : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), SorterByUDFC03_val);
-        else
-            ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterByUDFC03)
-                  : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), SorterByUDFC03);
-        break;
-    case TransactionListCtrl::COL_UDFC04:
-        type = Model_CustomField::getUDFCType(ref_type, "UDFC04");
-        if (type == Model_CustomField::FIELDTYPE::DECIMAL || type == Model_CustomField::FIELDTYPE::INTEGER)
-            ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterByUDFC04_val)
-                  : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), SorterByUDFC04_val);
-        else
-            ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterByUDFC04)
-                  : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), SorterByUDFC04);
-        break;
-    case TransactionListCtrl::COL_UDFC05:
-        type = Model_CustomField::getUDFCType(ref_type, "UDFC05");
-        if (type == Model_CustomField::FIELDTYPE::DECIMAL || type == Model_CustomField::FIELDTYPE::INTEGER)
-            ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterByUDFC05_val)
-                  : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), SorterByUDFC05_val);
-        else
-            ascend ? std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterByUDFC05)
-                  : std::stable_sort(this->m_trans.rbegin(), this->m_trans.rend(), SorterByUDFC05);
-        break;
-    default:
-        break;
+        if (x.number != y.number) return x.number < y.number ? -1 : 1;
+        return x.text.compare(y.text);
     }
+
+    SortKey NumberKey(double number) { return SortKey{ number, std::wstring() }; }
+    SortKey TextKey(const wxString& text) { return SortKey{ 0, text.ToStdWstring() }; }
+
+    /* numeric: the custom field shown in a UDFC column holds decimals or integers */
+    SortKey ColumnKey(TransactionListCtrl::EColumn col, bool numeric, const Model_Checking::Full_Data& tran)
+    {
+        switch (col)
+        {
+        case TransactionListCtrl::COL_ID: return NumberKey(tran.TRANSID);
+        case TransactionListCtrl::COL_NUMBER:
+            // empty first as before, then numbers in numeric order, then the other texts
+            if (tran.TRANSACTIONNUMBER.empty())
+                return NumberKey(std::numeric_limits<double>::lowest());
+            return tran.TRANSACTIONNUMBER.IsNumber()
+                ? NumberKey(wxAtoi(tran.TRANSACTIONNUMBER))
+                : SortKey{ std::numeric_limits<double>::max(), tran.TRANSACTIONNUMBER.ToStdWstring() };
+        case TransactionListCtrl::COL_ACCOUNT: return SortKey{ 0, SorterByACCOUNTNAME::key(tran) };
+        case TransactionListCtrl::COL_PAYEE_STR: return SortKey{ 0, SorterByPAYEENAME::key(tran) };
+        case TransactionListCtrl::COL_STATUS: return TextKey(tran.STATUS);
+        case TransactionListCtrl::COL_CATEGORY: return SortKey{ 0, SorterByCATEGNAME::key(tran) };
+        case TransactionListCtrl::COL_WITHDRAWAL: return NumberKey(-tran.AMOUNT);
+        case TransactionListCtrl::COL_DEPOSIT: return NumberKey(tran.AMOUNT);
+        case TransactionListCtrl::COL_BALANCE:
+        case TransactionListCtrl::COL_CREDIT: return NumberKey(tran.BALANCE);
+        case TransactionListCtrl::COL_NOTES: return SortKey{ 0, SorterByNOTES::key(tran) };
+        case TransactionListCtrl::COL_DATE: return NumberKey(tran.TRANSDATE_date().GetValue());
+        case TransactionListCtrl::COL_DELETEDTIME: return TextKey(tran.DELETEDTIME);
+        case TransactionListCtrl::COL_UDFC01: return numeric ? NumberKey(tran.UDFC01_val) : TextKey(tran.UDFC01);
+        case TransactionListCtrl::COL_UDFC02: return numeric ? NumberKey(tran.UDFC02_val) : TextKey(tran.UDFC02);
+        case TransactionListCtrl::COL_UDFC03: return numeric ? NumberKey(tran.UDFC03_val) : TextKey(tran.UDFC03);
+        case TransactionListCtrl::COL_UDFC04: return numeric ? NumberKey(tran.UDFC04_val) : TextKey(tran.UDFC04);
+        case TransactionListCtrl::COL_UDFC05: return numeric ? NumberKey(tran.UDFC05_val) : TextKey(tran.UDFC05);
+        default: return NumberKey(0);
+        }
+    }
+}
+
+void TransactionListCtrl::SortTransactions(int sortcol, bool ascend, int prev_sortcol, bool prev_ascend)
+{
+    mmTrace::Scope trace("TransactionListCtrl::SortTransactions");
+    const auto& ref_type = Model_Attachment::reftype_desc(Model_Attachment::TRANSACTION);
+    const auto is_numeric = [&ref_type](EColumn col) -> bool
+    {
+        if (col < COL_UDFC01 || col > COL_UDFC05) return false;
+        const auto type = Model_CustomField::getUDFCType(ref_type, wxString::Format("UDFC%02d", col - COL_UDFC01 + 1));
+        return type == Model_CustomField::FIELDTYPE::DECIMAL || type == Model_CustomField::FIELDTYPE::INTEGER;
+    };
+    const EColumn col = m_real_columns[sortcol], prev_col = m_real_columns[prev_sortcol];
+    const bool numeric = is_numeric(col), prev_numeric = is_numeric(prev_col);
+
+    // both columns' keys are computed once per row, the rows are then ordered by index
+    struct Row
+    {
+        SortKey key, prev_key;
+        size_t index;
+    };
+    std::vector<Row> rows;
+    rows.reserve(m_trans.size());
+    for (size_t i = 0; i < m_trans.size(); i++)
+        rows.push_back(Row{ ColumnKey(col, numeric, m_trans[i]), ColumnKey(prev_col, prev_numeric, m_trans[i]), i });
+
+    std::sort(rows.begin(), rows.end(), [ascend, prev_ascend](const Row& x, const Row& y) -> bool
+    {
+        int c = Compare(x.key, y.key);
+        if (c != 0) return ascend ? c < 0 : c > 0;
+        c = Compare(x.prev_key, y.prev_key);
+        if (c != 0) return prev_ascend ? c < 0 : c > 0;
+        return x.index < y.index;
+    });
+
+    Model_Checking::Full_Data_Set sorted;
+    sorted.reserve(m_trans.size());
+    for (const auto& row : rows)
+        sorted.push_back(m_trans[row.index]);
+    m_trans.swap(sorted);
 }
 
 void TransactionListCtrl::sortTable()
 {
     if (m_trans.empty()) return;
 
-    SortTransactions(prev_g_sortcol, prev_g_asc);
-    SortTransactions(g_sortcol, g_asc);
+    SortTransactions(g_sortcol, g_asc, prev_g_sortcol, prev_g_asc);
 
     wxString sortText = wxString::Format("%s: %s %s / %s %s", _("Sort Order")
                         , m_columns[g_sortcol].HEADER, g_asc ? L"\u25B2" : L"\u25BC"
@@ -548,9 +531,8 @@ void TransactionListCtrl::OnMarkTransaction(wxCommandEvent& event)
         if (GetItemState(row, wxLIST_STATE_SELECTED) == wxLIST_STATE_SELECTED)
         {
             Model_Account::Data* account = Model_Account::instance().get(m_trans[row].ACCOUNTID);
-            const auto statement_date = Model_Account::DateOf(account->STATEMENTDATE).FormatISODate();
             if (!Model_Account::BoolOf(account->STATEMENTLOCKED)
-                || m_trans[row].TRANSDATE > statement_date)
+                || m_trans[row].TRANSDATE_date() > account->STATEMENTDATE_date())
             {
                 //bRefreshRequired |= (status == "V") || (m_trans[row].STATUS == "V");
                 m_trans[row].STATUS = status;
@@ -1072,56 +1054,56 @@ void TransactionListCtrl::OnDeleteViewedTransaction(wxCommandEvent& event)
 
 void TransactionListCtrl::DeleteTransactionsByStatus(const wxString& status)
 {
-    int retainDays = Model_Setting::instance().GetIntSetting("DELETED_TRANS_RETAIN_DAYS", 30);
-    wxString deletionTime = wxDateTime::Now().ToUTC().FormatISOCombined();
-    std::set<std::pair<wxString, int>> assetStockAccts;
     const auto s = Model_Checking::toShortStatus(status);
-    Model_Checking::instance().Savepoint();
-    Model_Attachment::instance().Savepoint();
-    Model_Splittransaction::instance().Savepoint();
-    Model_CustomFieldData::instance().Savepoint();
+    std::vector<int> ids;
     for (const auto& tran : this->m_trans)
     {
         if (tran.STATUS == s || (s.empty() && status.empty()))
+            ids.push_back(tran.TRANSID);
+    }
+    DeleteTransactions(ids);
+}
+
+void TransactionListCtrl::DeleteTransactions(const std::vector<int>& ids)
+{
+    int retainDays = Model_Setting::instance().GetIntSetting("DELETED_TRANS_RETAIN_DAYS", 30);
+    try
+    {
+        if (m_cp->isTrash_ || retainDays == 0)
         {
-            if (m_cp->isTrash_ || retainDays == 0) {
-                // remove also removes any split transactions & translink entries
-                Model_Checking::instance().remove(tran.TRANSID);
+            Model_Checking::instance().Savepoint();
+            try
+            {
+                // remove also removes split transactions, share info & translink entries
+                const auto removed = Model_Checking::instance().remove(ids);
 
                 const wxString& RefType = Model_Attachment::reftype_desc(Model_Attachment::TRANSACTION);
 
-                // remove also any attachments
-                mmAttachmentManage::DeleteAllAttachments(RefType, tran.TRANSID);
-
                 // remove also any custom fields for the transaction
-                Model_CustomFieldData::DeleteAllData(RefType, tran.TRANSID);
+                Model_CustomFieldData::DeleteAllData(RefType, removed);
+
+                // remove also any attachments, last as their files cannot be rolled back
+                mmAttachmentManage::DeleteAllAttachments(RefType, removed);
             }
-            else {
-                Model_Checking::Data* trx = Model_Checking::instance().get(tran.TRANSID);
-                trx->DELETEDTIME = deletionTime;
-                Model_Checking::instance().save(trx);
-                Model_Translink::Data_Set translink = Model_Translink::instance().find(Model_Translink::CHECKINGACCOUNTID(trx->TRANSID));
-                if (!translink.empty()) {
-                    assetStockAccts.insert(std::make_pair(translink.at(0).LINKTYPE, translink.at(0).LINKRECORDID));
-                }
+            catch (const wxSQLite3Exception&)
+            {
+                Model_Checking::instance().Rollback();
+                Model_Checking::instance().ReleaseSavepoint();
+                throw;
             }
+            Model_Checking::instance().ReleaseSavepoint();
         }
-    }
-
-    if (!assetStockAccts.empty()) {
-        for (const auto& i : assetStockAccts) {
-            if (i.first == "Asset") Model_Translink::UpdateAssetValue(Model_Asset::instance().get(i.second));
-            else if (i.first == "Stock") Model_Translink::UpdateStockValue(Model_Stock::instance().get(i.second));
+        else
+        {
+            Model_Checking::instance().trash(ids, wxDateTime::Now().ToUTC().FormatISOCombined());
         }
     }
-
-    Model_Splittransaction::instance().ReleaseSavepoint();
-    Model_Attachment::instance().ReleaseSavepoint();
-    Model_Checking::instance().ReleaseSavepoint();
-    Model_CustomFieldData::instance().ReleaseSavepoint();
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogError("%s", e.GetMessage());
+    }
 }
 
-
 void TransactionListCtrl::OnDeleteTransaction(wxCommandEvent& WXUNUSED(event))
 {
     // check if any transactions selected
@@ -1150,12 +1132,7 @@ void TransactionListCtrl::OnDeleteTransaction(wxCommandEvent& WXUNUSED(event))
 
     if (msgDlg.ShowModal() == wxID_YES)
     {
-        wxString deletionTime = wxDateTime::Now().ToUTC().FormatISOCombined();
-        std::set<std::pair<wxString, int>> assetStockAccts;
-        Model_Checking::instance().Savepoint();
-        Model_Attachment::instance().Savepoint();
-        Model_Splittransaction::instance().Savepoint();
-        Model_CustomFieldData::instance().Savepoint();
+        std::vector<int> ids;
         for (const auto& i : m_selected_id)
         {
             Model_Checking::Data* trx = Model_Checking::instance().get(i);
@@ -1164,42 +1141,12 @@ void TransactionListCtrl::OnDeleteTransaction(wxCommandEvent& WXUNUSED(event))
                 continue;
             }
 
-            if (m_cp->isTrash_ || retainDays == 0) {
-                // remove also removes split transactions & translink entries
-                Model_Checking::instance().remove(i);
-
-                const wxString& RefType = Model_Attachment::reftype_desc(Model_Attachment::TRANSACTION);
-
-                // remove also any attachments
-                mmAttachmentManage::DeleteAllAttachments(RefType, i);
-                
-                // remove also any custom fields for the transaction
-                Model_CustomFieldData::DeleteAllData(RefType, i);
-
-            }
-            else {
-                trx->DELETEDTIME = deletionTime;
-                Model_Checking::instance().save(trx);
-                Model_Translink::Data_Set translink = Model_Translink::instance().find(Model_Translink::CHECKINGACCOUNTID(trx->TRANSID));
-                if (!translink.empty()) {
-                    assetStockAccts.insert(std::make_pair(translink.at(0).LINKTYPE, translink.at(0).LINKRECORDID));
-                }
-            }
+            ids.push_back(i);
             m_selectedForCopy.erase(std::remove(m_selectedForCopy.begin(), m_selectedForCopy.end(), i)
               , m_selectedForCopy.end());
         }
         m_selected_id.clear();
-        Model_CustomFieldData::instance().ReleaseSavepoint();
-        Model_Splittransaction::instance().ReleaseSavepoint();
-        Model_Attachment::instance().ReleaseSavepoint();
-        Model_Checking::instance().ReleaseSavepoint();
-
-        if (!assetStockAccts.empty()) {
-            for (const auto& i : assetStockAccts) {
-                if (i.first == "Asset") Model_Translink::UpdateAssetValue(Model_Asset::instance().get(i.second));
-                else if (i.first == "Stock") Model_Translink::UpdateStockValue(Model_Stock::instance().get(i.second));
-            }
-        }
+        DeleteTransactions(ids);
     }
     refreshVisualList();
     m_cp->m_frame->RefreshNavigationTree();
@@ -1211,10 +1158,10 @@ bool TransactionListCtrl::TransactionLocked(int accountID, const wxString& trans
     Model_Account::Data* account = Model_Account::instance().get(accountID);
     if (Model_Account::BoolOf(account->STATEMENTLOCKED))
     {
-        wxDateTime transaction_date;
-        if (transaction_date.ParseDate(transdate))
+        const mmDate transaction_date = mmDate::FromISO(transdate);
+        if (transaction_date.IsValid())
         {
-            if (transaction_date <= Model_Account::DateOf(account->STATEMENTDATE))
+            if (transaction_date <= account->STATEMENTDATE_date())
             {
                 wxMessageBox(_(wxString::Format(
                     _("Locked transaction to date: %s\n\n"
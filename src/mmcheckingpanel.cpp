@@ -28,6 +28,7 @@
 #include "mmex.h"
 #include "mmframe.h"
 #include "mmTips.h"
+#include "mmTrace.h"
 #include "mmSimpleDialogs.h"
 #include "splittransactionsdialog.h"
 #include "transdialog.h"
@@ -90,6 +91,7 @@ bool mmCheckingPanel::Create(
     const wxSize& size, long style, const wxString& name
 )
 {
+    mmTrace::Scope trace("Account panel");
     if (isAllAccounts_ || isTrash_) {
         m_currency = Model_Currency::GetBaseCurrency();
     }
@@ -116,7 +118,7 @@ bool mmCheckingPanel::Create(
     RefreshList();
     this->windowsFreezeThaw();
 
-    Model_Usage::instance().pageview(this);
+    Model_Usage::instance().pageview(this, trace.elapsed());
     return true;
 }
 
@@ -127,6 +129,7 @@ void mmCheckingPanel::sortTable()
 
 void mmCheckingPanel::filterTable()
 {
+    mmTrace::Scope trace("filterTable");
     m_listCtrlAccount->m_trans.clear();
 
     m_account_balance = !isAllAccounts_ && !isTrash_ && m_account ? m_account->INITIALBAL : 0.0;
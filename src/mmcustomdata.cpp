@@ -534,6 +534,36 @@ void mmCustomData::UpdateCustomValues(int ref_id)
     Model_CustomFieldData::instance().ReleaseSavepoint();
 }
 
+void mmCustomData::UpdateCustomValues(const std::vector<int>& ref_ids)
+{
+    Model_CustomFieldData::instance().Savepoint();
+    try
+    {
+        for (const auto& field : m_fields)
+        {
+            wxWindowID controlID = GetBaseID() + field.FIELDID * FIELDMULTIPLIER;
+            wxCheckBox* Description = static_cast<wxCheckBox*>(m_dialog->FindWindow(controlID + CONTROLOFFSET));
+            if (!Description || !Description->GetValue())
+                continue;
+
+            const auto& data = GetWidgetData(controlID);
+            if (!data.empty())
+                Model_CustomFieldData::instance().SetAllData(field.FIELDID, ref_ids, data);
+            else
+                Model_CustomFieldData::instance().remove_in(Model_CustomFieldData::REFID::name(), ref_ids
+                    , wxString::Format("FIELDID = %i", field.FIELDID));
+        }
+    }
+    catch (const wxSQLite3Exception&)
+    {
+        Model_CustomFieldData::instance().Rollback();
+        Model_CustomFieldData::instance().ReleaseSavepoint();
+        throw;
+    }
+
+    Model_CustomFieldData::instance().ReleaseSavepoint();
+}
+
 void mmCustomData::OnStringChanged(wxCommandEvent& event)
 {
     int controlID = event.GetId();
@@ -36,6 +36,8 @@ public:
     bool FillCustomFields(wxBoxSizer* box_sizer);
     bool SaveCustomValues(int ref_id);
     void UpdateCustomValues(int ref_id);
+    /* Apply the changed fields to many records at once */
+    void UpdateCustomValues(const std::vector<int>& ref_ids);
     void SetStringValue(int fieldID, const wxString& value, bool hasChanged = false);
     bool ValidateCustomValues(int ref_id);
     const wxString GetWidgetData(wxWindowID controlID) const;
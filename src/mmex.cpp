@@ -19,10 +19,12 @@
 
 #include "mmex.h"
 #include "constants.h"
+#include "dbupgrade.h"
 #include "mmframe.h"
 #include "mmSimpleDialogs.h"
 #include "paths.h"
 #include "platfdep.h"
+#include "quotes.h"
 #include "util.h"
 
 #include "model/Model_Setting.h"
@@ -37,7 +39,9 @@
 #include <wx/imagpng.h>
 #include "../resources/money.xpm"
  //----------------------------------------------------------------------------
+#ifndef MMEX_BENCH // mmex_bench provides its own console main()
 wxIMPLEMENT_APP(mmGUIApp);
+#endif
 //----------------------------------------------------------------------------
 
 static const wxCmdLineEntryDesc g_cmdLineDesc[] =
@@ -451,12 +455,17 @@ int mmGUIApp::OnExit()
 
     usage->JSONCONTENT = rj;
     Model_Usage::instance().save(usage);
+    Model_Setting::instance().Flush();
+
+    // the frame is gone, let a backup started on close finish writing
+    dbUpgrade::WaitForBackups();
 
     if (m_setting_db) {
         delete m_setting_db;
     }
 
-    /* CURL Cleanup */
+    /* CURL Cleanup, the quote service holds a multi handle until then */
+    mmQuoteService::instance().Shutdown();
     curl_global_cleanup();
 
     //Delete mmex temp folder for current user
@@ -28,6 +28,7 @@
 #include "appstartdialog.h"
 #include "assetspanel.h"
 #include "attachmentdialog.h"
+#include "autocomplete.h"
 #include "billsdepositsdialog.h"
 #include "billsdepositspanel.h"
 #include "budgetingpanel.h"
@@ -50,8 +51,10 @@
 #include "mmreportspanel.h"
 #include "mmSimpleDialogs.h"
 #include "mmHook.h"
+#include "navtreemodel.h"
 #include "optiondialog.h"
 #include "payeedialog.h"
+#include "quotes.h"
 #include "relocatecategorydialog.h"
 #include "relocatepayeedialog.h"
 #include "recentfiles.h"
@@ -76,6 +79,8 @@
 
 #include <wx/fs_mem.h>
 #include <wx/busyinfo.h>
+#include <algorithm>
+#include <queue>
 #include <stack>
 
  //----------------------------------------------------------------------------
@@ -123,6 +128,7 @@ EVT_MENU(MENU_CONVERT_ENC_DB, mmGUIFrame::OnConvertEncryptedDB)
 EVT_MENU(MENU_CHANGE_ENCRYPT_PASSWORD, mmGUIFrame::OnChangeEncryptPassword)
 EVT_MENU(MENU_DB_VACUUM, mmGUIFrame::OnVacuumDB)
 EVT_MENU(MENU_DB_DEBUG, mmGUIFrame::OnDebugDB)
+EVT_MENU(MENU_DB_CHECK, mmGUIFrame::OnCheckDB)
 
 EVT_MENU(MENU_ASSETS, mmGUIFrame::OnAssets)
 EVT_MENU(MENU_CURRENCY, mmGUIFrame::OnCurrency)
@@ -193,6 +199,7 @@ EVT_MENU_RANGE(wxID_FILE1, wxID_FILE9, mmGUIFrame::OnRecentFiles)
 EVT_MENU(MENU_RECENT_FILES_CLEAR, mmGUIFrame::OnClearRecentFiles)
 EVT_MENU(MENU_VIEW_TOGGLE_FULLSCREEN, mmGUIFrame::OnToggleFullScreen)
 EVT_CLOSE(mmGUIFrame::OnClose)
+EVT_IDLE(mmGUIFrame::OnIdle)
 
 wxEND_EVENT_TABLE()
 //----------------------------------------------------------------------------
@@ -360,10 +367,17 @@ void mmGUIFrame::cleanup()
     // Backup the database according to user requirements
     if (Option::instance().DatabaseUpdated() && Model_Setting::instance().GetBoolSetting("BACKUPDB_UPDATE", false))
     {
-        dbUpgrade::BackupDB(m_filename, dbUpgrade::BACKUPTYPE::CLOSE, Model_Setting::instance().GetIntSetting("MAX_BACKUP_FILES", 4));
+        dbUpgrade::BackupDB(m_filename, dbUpgrade::BACKUPTYPE::CLOSE, Model_Setting::instance().GetIntSetting("MAX_BACKUP_FILES", 4), 0, m_password);
     }
 }
 
+void mmGUIFrame::OnIdle(wxIdleEvent& event)
+{
+    if (m_db) Model_Infotable::instance().Flush();
+    Model_Setting::instance().Flush();
+    event.Skip();
+}
+
 void mmGUIFrame::ShutdownDatabase()
 {
     if (m_db)
@@ -372,12 +386,14 @@ void mmGUIFrame::ShutdownDatabase()
         {
             if (!db_lockInPlace)
                 Model_Infotable::instance().Set("ISUSED", false);
+            Model_Infotable::instance().Flush();
         }
         m_db->SetCommitHook(nullptr);
         m_db->Close();
         delete m_commit_callback_hook;
         delete m_update_callback_hook;
         m_db.reset();
+        mmAutoComplete::instance().Reset();
     }
 }
 
@@ -499,85 +515,140 @@ void mmGUIFrame::OnAutoRepeatTransactionsTimer(wxTimerEvent& /*event*/)
     }
 
     //Auto recurring transaction
-    bool continueExecution = false;
+    // Only schedules that are due are loaded and they are processed in order
+    // of their next occurrence date, re-queued after each executed occurrence
+    // until they catch up with today.
+    typedef std::pair<wxString, int> due_entry; // NEXTOCCURRENCEDATE, BDID
+    std::priority_queue<due_entry, std::vector<due_entry>, std::greater<due_entry>> due;
 
-    Model_Billsdeposits::AccountBalance bal;
     Model_Billsdeposits& bills = Model_Billsdeposits::instance();
-    for (const auto& q1 : bills.all())
+    const wxString today = wxDate::Today().FormatISODate();
+    for (const auto& q1 : bills.find(DB_Table_BILLSDEPOSITS_V1::NEXTOCCURRENCEDATE(today, LESS_OR_EQUAL)))
     {
         bills.decode_fields(q1);
-        const wxDateTime payment_date = bills.TRANSDATE(q1);
-        if (bills.autoExecuteManual() && bills.requireExecution())
+        if ((bills.autoExecuteManual() || bills.autoExecuteSilent()) && bills.allowExecution())
+            due.push(std::make_pair(q1.NEXTOCCURRENCEDATE, q1.BDID));
+    }
+    if (due.empty()) return;
+
+    bool refresh = false;
+    Model_Billsdeposits::AccountBalance bal;
+    // Silent occurrences are only collected while the queue drains, so every
+    // prompt is answered before the write transaction is opened
+    std::vector<std::pair<Model_Billsdeposits::Data, bool>> silent; // occurrence, allowed
+    std::map<int, Model_Billsdeposits::Data> advanced; // BDID, schedule past its collected occurrences
+    while (!due.empty())
+    {
+        const due_entry entry = due.top();
+        due.pop();
+
+        const auto pending = advanced.find(entry.second);
+        const Model_Billsdeposits::Data* bill = pending != advanced.end() ? &pending->second : bills.get(entry.second);
+        if (!bill || bill->BDID != entry.second) continue;
+        const Model_Billsdeposits::Data q1 = *bill;
+
+        bills.decode_fields(q1);
+        if (!bills.requireExecution() || !bills.allowExecution())
+            continue;
+
+        if (bills.autoExecuteManual())
         {
-            if (bills.allowExecution() && bills.AllowTransaction(q1, bal))
-            {
-                continueExecution = true;
-                mmBDDialog repeatTransactionsDlg(this, q1.BDID, false, true);
-                repeatTransactionsDlg.SetDialogHeader(_("Auto Repeat Transactions"));
-                if (repeatTransactionsDlg.ShowModal() == wxID_OK)
-                {
-                    refreshPanelData();
-                }
-                else // stop repeat executions from occuring
-                    continueExecution = false;
-            }
+            if (!bills.AllowTransaction(q1, bal))
+                continue;
+            mmBDDialog repeatTransactionsDlg(this, q1.BDID, false, true);
+            repeatTransactionsDlg.SetDialogHeader(_("Auto Repeat Transactions"));
+            // Cancel skips this schedule until the database is opened again;
+            // the other due schedules are still offered in this pass.
+            if (repeatTransactionsDlg.ShowModal() != wxID_OK)
+                continue;
+            refresh = true;
         }
+        else if (bills.autoExecuteSilent())
+        {
+            silent.push_back(std::make_pair(q1, bills.AllowTransaction(q1, bal)));
+            Model_Billsdeposits::advanceInSeries(advanced[q1.BDID] = q1);
+        }
+
+        // Queue the next occurrence while it is still due
+        const auto after = advanced.find(q1.BDID);
+        const Model_Billsdeposits::Data* next = after != advanced.end()
+            ? (after->second.NUMOCCURRENCES != Model_Billsdeposits::REPEAT_NONE ? &after->second : nullptr)
+            : bills.get(q1.BDID);
+        if (next && next->BDID == q1.BDID && next->NEXTOCCURRENCEDATE > entry.first && next->NEXTOCCURRENCEDATE <= today)
+            due.push(std::make_pair(next->NEXTOCCURRENCEDATE, next->BDID));
+    }
 
-        if (bills.autoExecuteSilent() && bills.requireExecution())
+    if (!silent.empty())
+    {
+        Model_Checking::instance().Savepoint("MMEX_AutoRepeat");
+        try
         {
-            if (bills.allowExecution() && bills.AllowTransaction(q1, bal))
+            for (const auto& occurrence : silent)
             {
-                continueExecution = true;
-                Model_Checking::Data* tran = Model_Checking::instance().create();
-
-                tran->ACCOUNTID = q1.ACCOUNTID;
-                tran->TOACCOUNTID = q1.TOACCOUNTID;
-                tran->PAYEEID = q1.PAYEEID;
-                tran->TRANSCODE = q1.TRANSCODE;
-                tran->TRANSAMOUNT = q1.TRANSAMOUNT;
-                tran->TOTRANSAMOUNT = q1.TOTRANSAMOUNT;
-                tran->STATUS = q1.STATUS;
-                tran->TRANSACTIONNUMBER = q1.TRANSACTIONNUMBER;
-                tran->NOTES = q1.NOTES;
-                tran->CATEGID = q1.CATEGID;
-                tran->FOLLOWUPID = q1.FOLLOWUPID;
-                tran->TRANSDATE = payment_date.FormatISODate();
-
-                int transID = Model_Checking::instance().save(tran);
-
-                Model_Splittransaction::Cache checking_splits;
-                for (const auto &item : Model_Billsdeposits::splittransaction(q1))
+                const Model_Billsdeposits::Data& q1 = occurrence.first;
+                if (occurrence.second)
                 {
-                    Model_Splittransaction::Data *split = Model_Splittransaction::instance().create();
-                    split->TRANSID = transID;
-                    split->CATEGID = item.CATEGID;
-                    split->SPLITTRANSAMOUNT = item.SPLITTRANSAMOUNT;
-                    split->NOTES = item.NOTES;
-                    checking_splits.push_back(split);
-                }
-                Model_Splittransaction::instance().save(checking_splits);
+                    Model_Checking::Data* tran = Model_Checking::instance().create();
+
+                    tran->ACCOUNTID = q1.ACCOUNTID;
+                    tran->TOACCOUNTID = q1.TOACCOUNTID;
+                    tran->PAYEEID = q1.PAYEEID;
+                    tran->TRANSCODE = q1.TRANSCODE;
+                    tran->TRANSAMOUNT = q1.TRANSAMOUNT;
+                    tran->TOTRANSAMOUNT = q1.TOTRANSAMOUNT;
+                    tran->STATUS = q1.STATUS;
+                    tran->TRANSACTIONNUMBER = q1.TRANSACTIONNUMBER;
+                    tran->NOTES = q1.NOTES;
+                    tran->CATEGID = q1.CATEGID;
+                    tran->FOLLOWUPID = q1.FOLLOWUPID;
+                    tran->TRANSDATE = bills.TRANSDATE(q1).FormatISODate();
+
+                    int transID = Model_Checking::instance().save(tran);
+
+                    Model_Splittransaction::Cache checking_splits;
+                    for (const auto &item : Model_Billsdeposits::splittransaction(q1))
+                    {
+                        Model_Splittransaction::Data *split = Model_Splittransaction::instance().create();
+                        split->TRANSID = transID;
+                        split->CATEGID = item.CATEGID;
+                        split->SPLITTRANSAMOUNT = item.SPLITTRANSAMOUNT;
+                        split->NOTES = item.NOTES;
+                        checking_splits.push_back(split);
+                    }
+                    Model_Splittransaction::instance().save(checking_splits);
 
-                // Copy the custom fields to the newly created transaction
-                const auto& customDataSet = Model_CustomFieldData::instance().find(Model_CustomFieldData::REFID(-q1.BDID));
-                Model_CustomFieldData::instance().Savepoint();
-                for (const auto& entry : customDataSet)
-                {
-                    Model_CustomFieldData::Data* fieldData = Model_CustomFieldData::instance().create();
-                    fieldData->FIELDID = entry.FIELDID;
-                    fieldData->REFID = transID;
-                    fieldData->CONTENT = entry.CONTENT;
-                    Model_CustomFieldData::instance().save(fieldData);
+                    // Copy the custom fields to the newly created transaction
+                    for (const auto& field : Model_CustomFieldData::instance().find(Model_CustomFieldData::REFID(-q1.BDID)))
+                    {
+                        Model_CustomFieldData::Data* fieldData = Model_CustomFieldData::instance().create();
+                        fieldData->FIELDID = field.FIELDID;
+                        fieldData->REFID = transID;
+                        fieldData->CONTENT = field.CONTENT;
+                        Model_CustomFieldData::instance().save(fieldData);
+                    }
                 }
-                Model_CustomFieldData::instance().ReleaseSavepoint();
+                bills.completeBDInSeries(q1.BDID);
             }
-            Model_Billsdeposits::instance().completeBDInSeries(q1.BDID);
-            createHomePage();
+            Model_Checking::instance().ReleaseSavepoint("MMEX_AutoRepeat");
+        }
+        catch (const wxSQLite3Exception& e)
+        {
+            Model_Checking::instance().Rollback("MMEX_AutoRepeat");
+            Model_Checking::instance().ReleaseSavepoint("MMEX_AutoRepeat");
+            // The caches still hold the rows of the rolled back inserts and updates
+            Model_Checking::instance().destroy_cache();
+            Model_Splittransaction::instance().destroy_cache();
+            Model_CustomFieldData::instance().destroy_cache();
+            bills.destroy_cache();
+            wxLogError("%s: Exception %s", "MMEX_AutoRepeat", e.GetMessage().utf8_str());
         }
+        refresh = true;
     }
 
-    if (continueExecution)
+    if (refresh)
     {
-        autoRepeatTransactionsTimer_.Start(5, wxTIMER_ONE_SHOT);
+        createHomePage();
+        refreshPanelData();
     }
 }
 //----------------------------------------------------------------------------
@@ -652,6 +723,7 @@ void mmGUIFrame::menuEnableItems(bool enable)
 
     menuBar_->FindItem(MENU_DB_VACUUM)->Enable(enable);
     menuBar_->FindItem(MENU_DB_DEBUG)->Enable(enable);
+    menuBar_->FindItem(MENU_DB_CHECK)->Enable(enable);
 
     toolBar_->EnableTool(MENU_NEWACCT, enable);
     toolBar_->EnableTool(MENU_HOMEPAGE, enable);
@@ -708,85 +780,86 @@ void mmGUIFrame::createControls()
 void mmGUIFrame::DoRecreateNavTreeControl()
 {
     DoWindowsFreezeThaw(m_nav_tree_ctrl);
-    resetNavTreeControl();
 
-    wxTreeItemId  root = m_nav_tree_ctrl->AddRoot(_("Home Page"), img::HOUSE_PNG, img::HOUSE_PNG);
-    m_nav_tree_ctrl->SetItemData(root, new mmTreeItemData(mmTreeItemData::HOME_PAGE, "Home Page"));
-    m_nav_tree_ctrl->SetItemBold(root, true);
+    // build the wanted tree off-screen, then only touch the nodes that differ
+    mmNavTreeModel nav;
+    wxTreeItemId  root = nav.AddRoot(_("Home Page"), img::HOUSE_PNG, img::HOUSE_PNG);
+    nav.SetItemData(root, new mmTreeItemData(mmTreeItemData::HOME_PAGE, "Home Page"));
+    nav.SetItemBold(root, true);
 
-    wxTreeItemId alltransactions = m_nav_tree_ctrl->AppendItem(root, _("All Transactions"), img::ALLTRANSACTIONS_PNG, img::ALLTRANSACTIONS_PNG);
-    m_nav_tree_ctrl->SetItemData(alltransactions, new mmTreeItemData(mmTreeItemData::ALL_TRANSACTIONS, "All Transactions"));
-    m_nav_tree_ctrl->SetItemBold(alltransactions, true);
+    wxTreeItemId alltransactions = nav.AppendItem(root, _("All Transactions"), img::ALLTRANSACTIONS_PNG, img::ALLTRANSACTIONS_PNG);
+    nav.SetItemData(alltransactions, new mmTreeItemData(mmTreeItemData::ALL_TRANSACTIONS, "All Transactions"));
+    nav.SetItemBold(alltransactions, true);
 
-    wxTreeItemId favourites = m_nav_tree_ctrl->AppendItem(root, _("Favourites"), img::FAVOURITE_PNG, img::FAVOURITE_PNG);
-    m_nav_tree_ctrl->SetItemData(favourites, new mmTreeItemData(mmTreeItemData::MENU_FAVORITES, "Favourites"));
-    m_nav_tree_ctrl->SetItemBold(favourites, true);
+    wxTreeItemId favourites = nav.AppendItem(root, _("Favourites"), img::FAVOURITE_PNG, img::FAVOURITE_PNG);
+    nav.SetItemData(favourites, new mmTreeItemData(mmTreeItemData::MENU_FAVORITES, "Favourites"));
+    nav.SetItemBold(favourites, true);
 
-    wxTreeItemId accounts = m_nav_tree_ctrl->AppendItem(root, _("Bank Accounts"), img::SAVINGS_ACC_NORMAL_PNG, img::SAVINGS_ACC_NORMAL_PNG);
-    m_nav_tree_ctrl->SetItemData(accounts, new mmTreeItemData(mmTreeItemData::MENU_ACCOUNT, "Bank Accounts"));
-    m_nav_tree_ctrl->SetItemBold(accounts, true);
+    wxTreeItemId accounts = nav.AppendItem(root, _("Bank Accounts"), img::SAVINGS_ACC_NORMAL_PNG, img::SAVINGS_ACC_NORMAL_PNG);
+    nav.SetItemData(accounts, new mmTreeItemData(mmTreeItemData::MENU_ACCOUNT, "Bank Accounts"));
+    nav.SetItemBold(accounts, true);
 
-    wxTreeItemId cardAccounts = m_nav_tree_ctrl->AppendItem(root, _("Credit Card Accounts"), img::CARD_ACC_NORMAL_PNG, img::CARD_ACC_NORMAL_PNG);
-    m_nav_tree_ctrl->SetItemData(cardAccounts, new mmTreeItemData(mmTreeItemData::MENU_ACCOUNT, "Credit Card Accounts"));
-    m_nav_tree_ctrl->SetItemBold(cardAccounts, true);
+    wxTreeItemId cardAccounts = nav.AppendItem(root, _("Credit Card Accounts"), img::CARD_ACC_NORMAL_PNG, img::CARD_ACC_NORMAL_PNG);
+    nav.SetItemData(cardAccounts, new mmTreeItemData(mmTreeItemData::MENU_ACCOUNT, "Credit Card Accounts"));
+    nav.SetItemBold(cardAccounts, true);
 
-    wxTreeItemId cashAccounts = m_nav_tree_ctrl->AppendItem(root, _("Cash Accounts"), img::CASH_ACC_NORMAL_PNG, img::CASH_ACC_NORMAL_PNG);
-    m_nav_tree_ctrl->SetItemData(cashAccounts, new mmTreeItemData(mmTreeItemData::MENU_ACCOUNT, "Cash Accounts"));
-    m_nav_tree_ctrl->SetItemBold(cashAccounts, true);
+    wxTreeItemId cashAccounts = nav.AppendItem(root, _("Cash Accounts"), img::CASH_ACC_NORMAL_PNG, img::CASH_ACC_NORMAL_PNG);
+    nav.SetItemData(cashAccounts, new mmTreeItemData(mmTreeItemData::MENU_ACCOUNT, "Cash Accounts"));
+    nav.SetItemBold(cashAccounts, true);
 
-    wxTreeItemId loanAccounts = m_nav_tree_ctrl->AppendItem(root, _("Loan Accounts"), img::LOAN_ACC_NORMAL_PNG, img::LOAN_ACC_NORMAL_PNG);
-    m_nav_tree_ctrl->SetItemData(loanAccounts, new mmTreeItemData(mmTreeItemData::MENU_ACCOUNT, "Loan Accounts"));
-    m_nav_tree_ctrl->SetItemBold(loanAccounts, true);
+    wxTreeItemId loanAccounts = nav.AppendItem(root, _("Loan Accounts"), img::LOAN_ACC_NORMAL_PNG, img::LOAN_ACC_NORMAL_PNG);
+    nav.SetItemData(loanAccounts, new mmTreeItemData(mmTreeItemData::MENU_ACCOUNT, "Loan Accounts"));
+    nav.SetItemBold(loanAccounts, true);
 
-    wxTreeItemId termAccounts = m_nav_tree_ctrl->AppendItem(root, _("Term Accounts"), img::TERMACCOUNT_NORMAL_PNG, img::TERMACCOUNT_NORMAL_PNG);
-    m_nav_tree_ctrl->SetItemData(termAccounts, new mmTreeItemData(mmTreeItemData::MENU_ACCOUNT, "Term Accounts"));
-    m_nav_tree_ctrl->SetItemBold(termAccounts, true);
+    wxTreeItemId termAccounts = nav.AppendItem(root, _("Term Accounts"), img::TERMACCOUNT_NORMAL_PNG, img::TERMACCOUNT_NORMAL_PNG);
+    nav.SetItemData(termAccounts, new mmTreeItemData(mmTreeItemData::MENU_ACCOUNT, "Term Accounts"));
+    nav.SetItemBold(termAccounts, true);
 
-    wxTreeItemId stocks = m_nav_tree_ctrl->AppendItem(root, _("Stock Portfolios"), img::STOCK_ACC_NORMAL_PNG, img::STOCK_ACC_NORMAL_PNG);
-    m_nav_tree_ctrl->SetItemData(stocks, new mmTreeItemData(mmTreeItemData::HELP_PAGE_STOCKS, "Stock Portfolios"));
-    m_nav_tree_ctrl->SetItemBold(stocks, true);
+    wxTreeItemId stocks = nav.AppendItem(root, _("Stock Portfolios"), img::STOCK_ACC_NORMAL_PNG, img::STOCK_ACC_NORMAL_PNG);
+    nav.SetItemData(stocks, new mmTreeItemData(mmTreeItemData::HELP_PAGE_STOCKS, "Stock Portfolios"));
+    nav.SetItemBold(stocks, true);
 
-    wxTreeItemId shareAccounts = m_nav_tree_ctrl->AppendItem(root, _("Share Accounts"), img::STOCK_ACC_NORMAL_PNG, img::STOCK_ACC_NORMAL_PNG);
-    m_nav_tree_ctrl->SetItemData(shareAccounts, new mmTreeItemData(mmTreeItemData::MENU_ACCOUNT, "Share Accounts"));
-    m_nav_tree_ctrl->SetItemBold(shareAccounts, true);
+    wxTreeItemId shareAccounts = nav.AppendItem(root, _("Share Accounts"), img::STOCK_ACC_NORMAL_PNG, img::STOCK_ACC_NORMAL_PNG);
+    nav.SetItemData(shareAccounts, new mmTreeItemData(mmTreeItemData::MENU_ACCOUNT, "Share Accounts"));
+    nav.SetItemBold(shareAccounts, true);
 
-    wxTreeItemId assets = m_nav_tree_ctrl->AppendItem(root, _("Assets"), img::ASSET_NORMAL_PNG, img::ASSET_NORMAL_PNG);
-    m_nav_tree_ctrl->SetItemData(assets, new mmTreeItemData(mmTreeItemData::ASSETS, "Assets"));
-    m_nav_tree_ctrl->SetItemBold(assets, true);
+    wxTreeItemId assets = nav.AppendItem(root, _("Assets"), img::ASSET_NORMAL_PNG, img::ASSET_NORMAL_PNG);
+    nav.SetItemData(assets, new mmTreeItemData(mmTreeItemData::ASSETS, "Assets"));
+    nav.SetItemBold(assets, true);
 
-    wxTreeItemId bills = m_nav_tree_ctrl->AppendItem(root, _("Recurring Transactions"), img::SCHEDULE_PNG, img::SCHEDULE_PNG);
-    m_nav_tree_ctrl->SetItemData(bills, new mmTreeItemData(mmTreeItemData::BILLS, "Recurring Transactions"));
-    m_nav_tree_ctrl->SetItemBold(bills, true);
+    wxTreeItemId bills = nav.AppendItem(root, _("Recurring Transactions"), img::SCHEDULE_PNG, img::SCHEDULE_PNG);
+    nav.SetItemData(bills, new mmTreeItemData(mmTreeItemData::BILLS, "Recurring Transactions"));
+    nav.SetItemBold(bills, true);
 
-    wxTreeItemId trash = m_nav_tree_ctrl->AppendItem(root, _("Deleted Transactions"), img::TRASH_PNG, img::TRASH_PNG);
-    m_nav_tree_ctrl->SetItemData(trash, new mmTreeItemData(mmTreeItemData::TRASH, "Deleted Transactions"));
-    m_nav_tree_ctrl->SetItemBold(trash, true);
+    wxTreeItemId trash = nav.AppendItem(root, _("Deleted Transactions"), img::TRASH_PNG, img::TRASH_PNG);
+    nav.SetItemData(trash, new mmTreeItemData(mmTreeItemData::TRASH, "Deleted Transactions"));
+    nav.SetItemBold(trash, true);
 
-    wxTreeItemId budgeting = m_nav_tree_ctrl->AppendItem(root, _("Budget Setup"), img::CALENDAR_PNG, img::CALENDAR_PNG);
-    m_nav_tree_ctrl->SetItemData(budgeting, new mmTreeItemData(mmTreeItemData::HELP_BUDGET, "Budget Setup"));
-    m_nav_tree_ctrl->SetItemBold(budgeting, true);
-    this->DoUpdateBudgetNavigation(budgeting);
+    wxTreeItemId budgeting = nav.AppendItem(root, _("Budget Setup"), img::CALENDAR_PNG, img::CALENDAR_PNG);
+    nav.SetItemData(budgeting, new mmTreeItemData(mmTreeItemData::HELP_BUDGET, "Budget Setup"));
+    nav.SetItemBold(budgeting, true);
+    this->DoUpdateBudgetNavigation(nav, budgeting);
 
-    wxTreeItemId transactionFilter = m_nav_tree_ctrl->AppendItem(root, _("Transaction Report"), img::FILTER_PNG, img::FILTER_PNG);
-    m_nav_tree_ctrl->SetItemBold(transactionFilter, true);
-    m_nav_tree_ctrl->SetItemData(transactionFilter, new mmTreeItemData(mmTreeItemData::FILTER, "Transaction Report"));
-    this->DoUpdateFilterNavigation(transactionFilter);
+    wxTreeItemId transactionFilter = nav.AppendItem(root, _("Transaction Report"), img::FILTER_PNG, img::FILTER_PNG);
+    nav.SetItemBold(transactionFilter, true);
+    nav.SetItemData(transactionFilter, new mmTreeItemData(mmTreeItemData::FILTER, "Transaction Report"));
+    this->DoUpdateFilterNavigation(nav, transactionFilter);
 
-    wxTreeItemId reports = m_nav_tree_ctrl->AppendItem(root, _("Reports"), img::PIECHART_PNG, img::PIECHART_PNG);
-    m_nav_tree_ctrl->SetItemBold(reports, true);
-    m_nav_tree_ctrl->SetItemData(reports, new mmTreeItemData(mmTreeItemData::HELP_REPORT, "Reports"));
-    this->DoUpdateReportNavigation(reports);
+    wxTreeItemId reports = nav.AppendItem(root, _("Reports"), img::PIECHART_PNG, img::PIECHART_PNG);
+    nav.SetItemBold(reports, true);
+    nav.SetItemData(reports, new mmTreeItemData(mmTreeItemData::HELP_REPORT, "Reports"));
+    this->DoUpdateReportNavigation(nav, reports);
 
-    wxTreeItemId grm = m_nav_tree_ctrl->AppendItem(root, _("General Report Manager"), img::CUSTOMSQL_GRP_PNG, img::CUSTOMSQL_GRP_PNG);
-    m_nav_tree_ctrl->SetItemBold(grm, true);
-    m_nav_tree_ctrl->SetItemData(grm, new mmTreeItemData(mmTreeItemData::HELP_PAGE_GRM, "General Report Manager"));
-    this->DoUpdateGRMNavigation(grm);
+    wxTreeItemId grm = nav.AppendItem(root, _("General Report Manager"), img::CUSTOMSQL_GRP_PNG, img::CUSTOMSQL_GRP_PNG);
+    nav.SetItemBold(grm, true);
+    nav.SetItemData(grm, new mmTreeItemData(mmTreeItemData::HELP_PAGE_GRM, "General Report Manager"));
+    this->DoUpdateGRMNavigation(nav, grm);
 
     ///////////////////////////////////////////////////////////////////
 
-    wxTreeItemId help = m_nav_tree_ctrl->AppendItem(root, _("Help"), img::HELP_PNG, img::HELP_PNG);
-    m_nav_tree_ctrl->SetItemData(help, new mmTreeItemData(mmTreeItemData::HELP_PAGE_MAIN, "Help"));
-    m_nav_tree_ctrl->SetItemBold(help, true);
+    wxTreeItemId help = nav.AppendItem(root, _("Help"), img::HELP_PNG, img::HELP_PNG);
+    nav.SetItemData(help, new mmTreeItemData(mmTreeItemData::HELP_PAGE_MAIN, "Help"));
+    nav.SetItemBold(help, true);
 
     if (m_db)
     {
@@ -812,8 +885,8 @@ void mmGUIFrame::DoRecreateNavTreeControl()
             {
                 if (Model_Account::type(account) != Model_Account::INVESTMENT)
                 {
-                    tacct = m_nav_tree_ctrl->AppendItem(favourites, account.ACCOUNTNAME, selectedImage, selectedImage);
-                    m_nav_tree_ctrl->SetItemData(tacct, new mmTreeItemData(mmTreeItemData::ACCOUNT, account.ACCOUNTID));
+                    tacct = nav.AppendItem(favourites, account.ACCOUNTNAME, selectedImage, selectedImage);
+                    nav.SetItemData(tacct, new mmTreeItemData(mmTreeItemData::ACCOUNT, account.ACCOUNTID));
                 }
             }
 
@@ -821,8 +894,8 @@ void mmGUIFrame::DoRecreateNavTreeControl()
             {
             case Model_Account::INVESTMENT:
             {
-                tacct = m_nav_tree_ctrl->AppendItem(stocks, account.ACCOUNTNAME, selectedImage, selectedImage);
-                m_nav_tree_ctrl->SetItemData(tacct, new mmTreeItemData(mmTreeItemData::STOCK, account.ACCOUNTID));
+                tacct = nav.AppendItem(stocks, account.ACCOUNTNAME, selectedImage, selectedImage);
+                nav.SetItemData(tacct, new mmTreeItemData(mmTreeItemData::STOCK, account.ACCOUNTID));
                 // find all the accounts associated with this stock portfolio
                 Model_Stock::Data_Set stock_account_list = Model_Stock::instance().find(Model_Stock::HELDAT(account.ACCOUNTID));
                 // Put the names of the Stock_entry names as children of the stock account.
@@ -830,84 +903,93 @@ void mmGUIFrame::DoRecreateNavTreeControl()
                 {
                     if (Model_Translink::HasShares(stock_entry.STOCKID))
                     {
-                        wxTreeItemId se = m_nav_tree_ctrl->AppendItem(tacct, stock_entry.STOCKNAME, selectedImage, selectedImage);
+                        wxTreeItemId se = nav.AppendItem(tacct, stock_entry.STOCKNAME, selectedImage, selectedImage);
                         int account_id = stock_entry.STOCKID;
                         if (Model_Translink::ShareAccountId(account_id))
                         {
-                            m_nav_tree_ctrl->SetItemData(se, new mmTreeItemData(mmTreeItemData::ACCOUNT, account_id));
+                            nav.SetItemData(se, new mmTreeItemData(mmTreeItemData::ACCOUNT, account_id));
                         }
                     }
                 }
                 break;
             }
             case Model_Account::CHECKING:
-                tacct = m_nav_tree_ctrl->AppendItem(accounts, account.ACCOUNTNAME, selectedImage, selectedImage);
-                m_nav_tree_ctrl->SetItemData(tacct, new mmTreeItemData(mmTreeItemData::ACCOUNT, account.ACCOUNTID));
+                tacct = nav.AppendItem(accounts, account.ACCOUNTNAME, selectedImage, selectedImage);
+                nav.SetItemData(tacct, new mmTreeItemData(mmTreeItemData::ACCOUNT, account.ACCOUNTID));
                 break;
             case Model_Account::SHARES:
-                tacct = m_nav_tree_ctrl->AppendItem(shareAccounts, account.ACCOUNTNAME, selectedImage, selectedImage);
-                m_nav_tree_ctrl->SetItemData(tacct, new mmTreeItemData(mmTreeItemData::ACCOUNT, account.ACCOUNTID));
+                tacct = nav.AppendItem(shareAccounts, account.ACCOUNTNAME, selectedImage, selectedImage);
+                nav.SetItemData(tacct, new mmTreeItemData(mmTreeItemData::ACCOUNT, account.ACCOUNTID));
                 break;
             case Model_Account::ASSET:
-                tacct = m_nav_tree_ctrl->AppendItem(assets, account.ACCOUNTNAME, selectedImage, selectedImage);
-                m_nav_tree_ctrl->SetItemData(tacct, new mmTreeItemData(mmTreeItemData::ACCOUNT, account.ACCOUNTID));
+                tacct = nav.AppendItem(assets, account.ACCOUNTNAME, selectedImage, selectedImage);
+                nav.SetItemData(tacct, new mmTreeItemData(mmTreeItemData::ACCOUNT, account.ACCOUNTID));
                 break;
             case Model_Account::TERM:
-                tacct = m_nav_tree_ctrl->AppendItem(termAccounts, account.ACCOUNTNAME, selectedImage, selectedImage);
-                m_nav_tree_ctrl->SetItemData(tacct, new mmTreeItemData(mmTreeItemData::ACCOUNT, account.ACCOUNTID));
+                tacct = nav.AppendItem(termAccounts, account.ACCOUNTNAME, selectedImage, selectedImage);
+                nav.SetItemData(tacct, new mmTreeItemData(mmTreeItemData::ACCOUNT, account.ACCOUNTID));
                 break;
             case Model_Account::CREDIT_CARD:
-                tacct = m_nav_tree_ctrl->AppendItem(cardAccounts, account.ACCOUNTNAME, selectedImage, selectedImage);
-                m_nav_tree_ctrl->SetItemData(tacct, new mmTreeItemData(mmTreeItemData::ACCOUNT, account.ACCOUNTID));
+                tacct = nav.AppendItem(cardAccounts, account.ACCOUNTNAME, selectedImage, selectedImage);
+                nav.SetItemData(tacct, new mmTreeItemData(mmTreeItemData::ACCOUNT, account.ACCOUNTID));
                 break;
             case Model_Account::CASH:
-                tacct = m_nav_tree_ctrl->AppendItem(cashAccounts, account.ACCOUNTNAME, selectedImage, selectedImage);
-                m_nav_tree_ctrl->SetItemData(tacct, new mmTreeItemData(mmTreeItemData::ACCOUNT, account.ACCOUNTID));
+                tacct = nav.AppendItem(cashAccounts, account.ACCOUNTNAME, selectedImage, selectedImage);
+                nav.SetItemData(tacct, new mmTreeItemData(mmTreeItemData::ACCOUNT, account.ACCOUNTID));
                 break;
             case Model_Account::LOAN:
-                tacct = m_nav_tree_ctrl->AppendItem(loanAccounts, account.ACCOUNTNAME, selectedImage, selectedImage);
-                m_nav_tree_ctrl->SetItemData(tacct, new mmTreeItemData(mmTreeItemData::ACCOUNT, account.ACCOUNTID));
+                tacct = nav.AppendItem(loanAccounts, account.ACCOUNTNAME, selectedImage, selectedImage);
+                nav.SetItemData(tacct, new mmTreeItemData(mmTreeItemData::ACCOUNT, account.ACCOUNTID));
                 break;
             }
 
         }
 
-        loadNavigationTreeItemsStatusFromJson();
-
-        if (!m_nav_tree_ctrl->ItemHasChildren(favourites)) {
-            m_nav_tree_ctrl->Delete(favourites);
+        if (!nav.ItemHasChildren(favourites)) {
+            nav.Delete(favourites);
         }
-        if (!m_nav_tree_ctrl->ItemHasChildren(accounts)) {
-            m_nav_tree_ctrl->Delete(accounts);
+        if (!nav.ItemHasChildren(accounts)) {
+            nav.Delete(accounts);
         }
-        if (!m_nav_tree_ctrl->ItemHasChildren(cardAccounts)) {
-            m_nav_tree_ctrl->Delete(cardAccounts);
+        if (!nav.ItemHasChildren(cardAccounts)) {
+            nav.Delete(cardAccounts);
         }
-        if (!m_nav_tree_ctrl->ItemHasChildren(termAccounts)) {
-            m_nav_tree_ctrl->Delete(termAccounts);
+        if (!nav.ItemHasChildren(termAccounts)) {
+            nav.Delete(termAccounts);
         }
-        if (!m_nav_tree_ctrl->ItemHasChildren(stocks)) {
-            m_nav_tree_ctrl->Delete(stocks);
+        if (!nav.ItemHasChildren(stocks)) {
+            nav.Delete(stocks);
         }
-        if (!m_nav_tree_ctrl->ItemHasChildren(cashAccounts)) {
-            m_nav_tree_ctrl->Delete(cashAccounts);
+        if (!nav.ItemHasChildren(cashAccounts)) {
+            nav.Delete(cashAccounts);
         }
-        if (!m_nav_tree_ctrl->ItemHasChildren(loanAccounts)) {
-            m_nav_tree_ctrl->Delete(loanAccounts);
+        if (!nav.ItemHasChildren(loanAccounts)) {
+            nav.Delete(loanAccounts);
         }
-        if (!m_nav_tree_ctrl->ItemHasChildren(shareAccounts) || Option::instance().HideShareAccounts())
+        if (!nav.ItemHasChildren(shareAccounts) || Option::instance().HideShareAccounts())
         {
-            m_nav_tree_ctrl->Delete(shareAccounts);
+            nav.Delete(shareAccounts);
         }
         if (Model_Checking::instance().find(Model_Checking::DELETEDTIME(wxEmptyString, NOT_EQUAL)).empty() || Option::instance().HideDeletedTransactions())
         {
-            m_nav_tree_ctrl->Delete(trash);
+            nav.Delete(trash);
             if (panelCurrent_ && panelCurrent_->GetId() == mmID_DELETEDTRANSACTIONS) {
                 wxCommandEvent event(wxEVT_MENU, MENU_HOMEPAGE);
                 GetEventHandler()->AddPendingEvent(event);
             }
         }
     }
+
+    SetEvtHandlerEnabled(false);
+    const std::vector<wxTreeItemId> inserted = nav.Apply(m_nav_tree_ctrl);
+    SetEvtHandlerEnabled(true);
+
+    // only new nodes get their saved expansion state, nodes that were kept
+    // stay as the user left them in this session
+    if (m_db && !inserted.empty())
+        loadNavigationTreeItemsStatusFromJson(inserted);
+
+    root = m_nav_tree_ctrl->GetRootItem();
     //m_nav_tree_ctrl->SelectItem(root);
     m_nav_tree_ctrl->EnsureVisible(root);
     m_nav_tree_ctrl->Refresh();
@@ -921,12 +1003,13 @@ void mmGUIFrame::DoRecreateNavTreeControl()
     DoWindowsFreezeThaw(m_nav_tree_ctrl);
 }
 
-void mmGUIFrame::loadNavigationTreeItemsStatusFromJson()
+void mmGUIFrame::loadNavigationTreeItemsStatusFromJson(const std::vector<wxTreeItemId>& subtrees)
 {
     /* Load Nav Tree Control */
     SetEvtHandlerEnabled(false);
     wxTreeItemId root = m_nav_tree_ctrl->GetRootItem();
-    m_nav_tree_ctrl->Expand(root);
+    if (std::find(subtrees.begin(), subtrees.end(), root) != subtrees.end())
+        m_nav_tree_ctrl->Expand(root);
 
     const wxString& str = Model_Infotable::instance().GetStringInfo("NAV_TREE_STATUS", "");
     Document json_doc;
@@ -935,8 +1018,9 @@ void mmGUIFrame::loadNavigationTreeItemsStatusFromJson()
     }
 
     std::stack<wxTreeItemId> items;
-    if (m_nav_tree_ctrl->GetRootItem().IsOk()) {
-        items.push(m_nav_tree_ctrl->GetRootItem());
+    for (const auto& item : subtrees)
+    {
+        if (item.IsOk()) items.push(item);
     }
 
     while (!items.empty())
@@ -1706,9 +1790,13 @@ void mmGUIFrame::createMenu()
     wxMenuItem* menuItemCheckDB = new wxMenuItem(menuTools, MENU_DB_DEBUG
         , __(wxTRANSLATE("Database De&bug"))
         , _("Generate database report or fix errors"));
+    wxMenuItem* menuItemIntegrityDB = new wxMenuItem(menuTools, MENU_DB_CHECK
+        , __(wxTRANSLATE("Check Database &Integrity"))
+        , _("Find and repair broken references between records"));
     menuDatabase->Append(menuItemConvertDB);
     menuDatabase->Append(menuItemChangeEncryptPassword);
     menuDatabase->Append(menuItemVacuumDB);
+    menuDatabase->Append(menuItemIntegrityDB);
     menuDatabase->Append(menuItemCheckDB);
     menuTools->AppendSubMenu(menuDatabase, _("Databa&se")
         , _("Database management"));
@@ -1881,6 +1969,7 @@ void mmGUIFrame::CreateToolBar()
 
 void mmGUIFrame::InitializeModelTables()
 {
+    mmAutoComplete::instance().Reset();
     m_all_models.push_back(&Model_Infotable::instance(m_db.get()));
     m_all_models.push_back(&Model_Asset::instance(m_db.get()));
     m_all_models.push_back(&Model_Stock::instance(m_db.get()));
@@ -1913,7 +2002,7 @@ bool mmGUIFrame::createDataStore(const wxString& fileName, const wxString& pwd,
         if (Option::instance().DatabaseUpdated() &&
             Model_Setting::instance().GetBoolSetting("BACKUPDB_UPDATE", false))
         {
-            dbUpgrade::BackupDB(m_filename, dbUpgrade::BACKUPTYPE::CLOSE, Model_Setting::instance().GetIntSetting("MAX_BACKUP_FILES", 4));
+            dbUpgrade::BackupDB(m_filename, dbUpgrade::BACKUPTYPE::CLOSE, Model_Setting::instance().GetIntSetting("MAX_BACKUP_FILES", 4), 0, m_password);
             Option::instance().DatabaseUpdated(false);
         }
     }
@@ -1940,7 +2029,7 @@ bool mmGUIFrame::createDataStore(const wxString& fileName, const wxString& pwd,
         /* Do a backup before opening */
         if (Model_Setting::instance().GetBoolSetting("BACKUPDB", false))
         {
-            dbUpgrade::BackupDB(fileName, dbUpgrade::BACKUPTYPE::START, Model_Setting::instance().GetIntSetting("MAX_BACKUP_FILES", 4));
+            dbUpgrade::BackupDB(fileName, dbUpgrade::BACKUPTYPE::START, Model_Setting::instance().GetIntSetting("MAX_BACKUP_FILES", 4), 0, password);
         }
 
         m_db = mmDBWrapper::Open(fileName, password);
@@ -1956,7 +2045,7 @@ bool mmGUIFrame::createDataStore(const wxString& fileName, const wxString& pwd,
         if (dbUpgrade::isUpgradeDBrequired(m_db.get()))
         {
             //DB backup is handled inside UpgradeDB
-            if (!dbUpgrade::UpgradeDB(m_db.get(), fileName))
+            if (!dbUpgrade::UpgradeDB(m_db.get(), fileName, password))
             {
                 int response = wxMessageBox(_("Have MMEX support provided you a debug/patch file?"), _("MMEX upgrade"), wxYES_NO);
                 if (response == wxYES)
@@ -2245,7 +2334,7 @@ void mmGUIFrame::OnChangeEncryptPassword(wxCommandEvent& /*event*/)
         wxString confirm_password = wxGetPasswordFromUser(_("Please confirm new password"), password_change_heading);
         if (!confirm_password.IsEmpty() && (new_password == confirm_password))
         {
-            m_db->ReKey(confirm_password);
+            mmDBWrapper::ReKey(m_db.get(), confirm_password);
             wxMessageBox(_("Password change completed."), password_change_heading);
         }
         else
@@ -2287,6 +2376,45 @@ void mmGUIFrame::OnDebugDB(wxCommandEvent& /*event*/)
 }
 //----------------------------------------------------------------------------
 
+void mmGUIFrame::OnCheckDB(wxCommandEvent& /*event*/)
+{
+    wxBusyCursor wait;
+    const auto results = dbCheck::checkDB(m_filename, m_password);
+    const wxString report = dbCheck::report(results);
+    if (report.empty())
+    {
+        wxMessageBox(_("No problems found in the database."), _("Database Integrity"));
+        return;
+    }
+
+    const bool repairable = dbCheck::isRepairable(results);
+    wxMessageDialog msgDlg(this, _("The database contains broken references:")
+        , _("Database Integrity"), repairable ? wxYES_NO | wxNO_DEFAULT | wxICON_WARNING : wxOK | wxICON_WARNING);
+    msgDlg.SetExtendedMessage(report + (repairable
+        ? "\n" + _("Make sure you have a backup of DB before repairing it") + "\n" + _("Do you want to repair the items that can be fixed automatically?")
+        : wxString("")));
+    if (msgDlg.ShowModal() != wxID_YES)
+        return;
+
+    const int changes = dbCheck::repairDB(m_db.get(), results);
+    if (changes < 0) return;
+
+    // reload the tables the repairs may have touched
+    Model_Checking::instance(m_db.get());
+    Model_Splittransaction::instance(m_db.get());
+    Model_Billsdeposits::instance(m_db.get());
+    Model_Budgetsplittransaction::instance(m_db.get());
+    Model_Payee::instance(m_db.get());
+    Model_Translink::instance(m_db.get());
+    Model_Shareinfo::instance(m_db.get());
+    Model_Budget::instance(m_db.get());
+    RefreshNavigationTree();
+    refreshPanelData();
+
+    wxMessageBox(wxString::Format(_("%i records repaired."), changes), _("Database Integrity"));
+}
+//----------------------------------------------------------------------------
+
 void mmGUIFrame::OnSaveAs(wxCommandEvent& /*event*/)
 {
     wxASSERT(m_db);
@@ -2665,9 +2793,13 @@ void mmGUIFrame::OnOptions(wxCommandEvent& /*event*/)
 {
     if (!m_db.get()) return;
 
+    const bool db_profile = Option::instance().getDatabasePerformanceProfile();
     mmOptionsDialog systemOptions(this, this->m_app);
     if (systemOptions.ShowModal() == wxID_OK)
     {
+        if (db_profile && !Option::instance().getDatabasePerformanceProfile())
+            mmDBWrapper::ClearPerformanceProfile(m_db.get());
+
         //set the View Menu Option items the same as the options saved.
         menuBar_->FindItem(MENU_VIEW_BUDGET_FINANCIAL_YEARS)->Check(Option::instance().BudgetFinancialYears());
         menuBar_->FindItem(MENU_VIEW_BUDGET_TRANSFER_TOTAL)->Check(Option::instance().BudgetIncludeTransfers());
@@ -3263,6 +3395,7 @@ void mmGUIFrame::OnRates(wxCommandEvent& WXUNUSED(event))
 #else
         (_("Downloading stock prices from Yahoo"), this);
 #endif
+    mmQuoteService::instance().ClearCache();
     wxString msg;
     getOnlineCurrencyRates(msg);
     wxLogDebug("%s", msg);
@@ -3650,7 +3783,7 @@ void mmGUIFrame::OnKeyDown(wxTreeEvent& event)
     event.Skip();
 }
 
-void mmGUIFrame::DoUpdateBudgetNavigation(wxTreeItemId& parent_item)
+void mmGUIFrame::DoUpdateBudgetNavigation(mmNavTreeModel& nav, wxTreeItemId& parent_item)
 {
     const auto all_budgets = Model_Budgetyear::instance().all(Model_Budgetyear::COL_BUDGETYEARNAME);
     if (!all_budgets.empty())
@@ -3685,13 +3818,13 @@ void mmGUIFrame::DoUpdateBudgetNavigation(wxTreeItemId& parent_item)
             for (const auto& e : all_budgets)
             {
                 if (entry.second == e.BUDGETYEARID) {
-                    year_budget = m_nav_tree_ctrl->AppendItem(parent_item, e.BUDGETYEARNAME, img::CALENDAR_PNG, img::CALENDAR_PNG);
-                    m_nav_tree_ctrl->SetItemData(year_budget, new mmTreeItemData(mmTreeItemData::BUDGET, e.BUDGETYEARID));
+                    year_budget = nav.AppendItem(parent_item, e.BUDGETYEARNAME, img::CALENDAR_PNG, img::CALENDAR_PNG);
+                    nav.SetItemData(year_budget, new mmTreeItemData(mmTreeItemData::BUDGET, e.BUDGETYEARID));
                 }
                 else if (pattern_month.Matches(e.BUDGETYEARNAME) && pattern_month.GetMatch(e.BUDGETYEARNAME, 1) == entry.first)
                 {
-                    wxTreeItemId month_budget = m_nav_tree_ctrl->AppendItem(year_budget, e.BUDGETYEARNAME, img::CALENDAR_PNG, img::CALENDAR_PNG);
-                    m_nav_tree_ctrl->SetItemData(month_budget, new mmTreeItemData(mmTreeItemData::BUDGET, e.BUDGETYEARID));
+                    wxTreeItemId month_budget = nav.AppendItem(year_budget, e.BUDGETYEARNAME, img::CALENDAR_PNG, img::CALENDAR_PNG);
+                    nav.SetItemData(month_budget, new mmTreeItemData(mmTreeItemData::BUDGET, e.BUDGETYEARID));
                 }
             }
         }
@@ -39,6 +39,7 @@ class mmPrintableBase;
 class mmPanelBase;
 class mmHomePagePanel;
 class mmTreeItemData;
+class mmNavTreeModel;
 class mmCheckingPanel;
 class mmReportsPanel;
 class mmStockPanel;
@@ -104,6 +105,9 @@ private:
     wxTimer autoRepeatTransactionsTimer_;
     void OnAutoRepeatTransactionsTimer(wxTimerEvent& event);
 
+    /* Write back settings modified since the last idle time */
+    void OnIdle(wxIdleEvent& event);
+
     /* controls */
     mmPanelBase* panelCurrent_;
 
@@ -150,16 +154,16 @@ private:
     void createBudgetingPage(int budgetYearID);
     void autocleanDeletedTransactions();
     void createControls();
-    /*Set nav tree items status from JSON data with stored in DB*/
-    void loadNavigationTreeItemsStatusFromJson();
+    /*Set the status of the given nav tree items and their descendants from JSON data stored in DB*/
+    void loadNavigationTreeItemsStatusFromJson(const std::vector<wxTreeItemId>& subtrees);
     /*save Settings LASTFILENAME AUIPERSPECTIVE SIZES*/
     void saveSettings();
     void menuEnableItems(bool enable);
     void DoRecreateNavTreeControl();
-    void DoUpdateReportNavigation(wxTreeItemId& parent_item);
-    void DoUpdateGRMNavigation(wxTreeItemId& parent_item);
-    void DoUpdateFilterNavigation(wxTreeItemId& parent_item);
-    void DoUpdateBudgetNavigation(wxTreeItemId& parent_item);
+    void DoUpdateReportNavigation(mmNavTreeModel& nav, wxTreeItemId& parent_item);
+    void DoUpdateGRMNavigation(mmNavTreeModel& nav, wxTreeItemId& parent_item);
+    void DoUpdateFilterNavigation(mmNavTreeModel& nav, wxTreeItemId& parent_item);
+    void DoUpdateBudgetNavigation(mmNavTreeModel& nav, wxTreeItemId& parent_item);
     void showTreePopupMenu(const wxTreeItemId& id, const wxPoint& pt);
     void AppendImportMenu(wxMenu& menu);
     void showBeginAppDialog(bool fromScratch = false);
@@ -173,6 +177,7 @@ private:
     void OnChangeEncryptPassword(wxCommandEvent& event);
     void OnVacuumDB(wxCommandEvent& event);
     void OnDebugDB(wxCommandEvent& event);
+    void OnCheckDB(wxCommandEvent& event);
     void OnSaveAs(wxCommandEvent& event);
     void OnExportToCSV(wxCommandEvent& event);
     void OnExportToXML(wxCommandEvent& event);
@@ -345,6 +350,7 @@ private:
         MENU_CHANGE_ENCRYPT_PASSWORD,
         MENU_DB_VACUUM,
         MENU_DB_DEBUG,
+        MENU_DB_CHECK,
         MENU_ONLINE_UPD_CURRENCY_RATE,
         MENU_ACCOUNT_REALLOCATE,
         MENU_DIAGNOSTICS,
@@ -582,6 +582,7 @@ const wxString htmlWidgetAssets::getHTMLText()
         return wxEmptyString;
     std::stable_sort(assets.begin(), assets.end(), SorterByVALUE());
     std::reverse(assets.begin(), assets.end());
+    const auto values = Model_Asset::instance().valueAtDate(assets, wxDate::Today());
 
     static const int MAX_ASSETS = 10;
     wxString output = "";
@@ -602,7 +603,7 @@ const wxString htmlWidgetAssets::getHTMLText()
     for (const auto& asset : assets)
     {
         double initial = asset.VALUE;
-        double current = Model_Asset::value(asset);
+        double current = values.at(asset.ASSETID);
         initialTotal += initial;
         currentTotal += current;
         if (rows++ < MAX_ASSETS)
@@ -23,6 +23,7 @@ Copyright (C) 2022 Mark Whalley (mark@ipx.co.uk)
 #include "mmhomepage.h"
 #include "mmex.h"
 #include "mmframe.h"
+#include "mmTrace.h"
 #include "paths.h"
 
 #include "html_template.h"
@@ -71,6 +72,7 @@ bool mmHomePagePanel::Create(wxWindow *parent
     , long style
     , const wxString& name)
 {
+    mmTrace::Scope trace("Home page");
     SetExtraStyle(GetExtraStyle() | wxWS_EX_BLOCK_EVENTS);
     wxPanelBase::Create(parent, winid, pos, size, style, name);
 
@@ -80,7 +82,7 @@ bool mmHomePagePanel::Create(wxWindow *parent
 
     createHtml();
 
-    Model_Usage::instance().pageview(this);
+    Model_Usage::instance().pageview(this, trace.elapsed());
 
     return TRUE;
 }
@@ -139,61 +141,83 @@ void mmHomePagePanel::insertDataIntoTemplate()
     double loanBalance = 0.0, loanReconciled = 0.0;
     //double shareBalance = 0.0, assetBalance = 0.0;
 
-    htmlWidgetAccounts account_stats;
-    m_frames["ACCOUNTS_INFO"] = account_stats.displayAccounts(tBalance, tReconciled, Model_Account::CHECKING);
-    m_frames["CARD_ACCOUNTS_INFO"] = account_stats.displayAccounts(cardBalance, cardReconciled, Model_Account::CREDIT_CARD);
-    tBalance += cardBalance;
-    tReconciled += cardReconciled;
-
-    // Accounts
-    m_frames["CASH_ACCOUNTS_INFO"] = account_stats.displayAccounts(cashBalance, cashReconciled, Model_Account::CASH);
-    tBalance += cashBalance;
-    tReconciled += cashReconciled;
-
-    m_frames["LOAN_ACCOUNTS_INFO"] = account_stats.displayAccounts(loanBalance, loanReconciled, Model_Account::LOAN);
-    tBalance += loanBalance;
-    tReconciled += loanReconciled;
-
-    m_frames["TERM_ACCOUNTS_INFO"] = account_stats.displayAccounts(termBalance, termReconciled, Model_Account::TERM);
-    tBalance += termBalance;
-    tReconciled += termReconciled;
-
-    //m_frames["ASSET_ACCOUNTS_INFO"] = account_stats.displayAccounts(assetBalance, Model_Account::ASSET);
-    //tBalance += assetBalance;
-
-    //m_frames["SHARE_ACCOUNTS_INFO"] = account_stats.displayAccounts(shareBalance, Model_Account::SHARES);
-    //tBalance += shareBalance;
+    {
+        mmTrace::Scope trace("Home accounts");
+        htmlWidgetAccounts account_stats;
+        m_frames["ACCOUNTS_INFO"] = account_stats.displayAccounts(tBalance, tReconciled, Model_Account::CHECKING);
+        m_frames["CARD_ACCOUNTS_INFO"] = account_stats.displayAccounts(cardBalance, cardReconciled, Model_Account::CREDIT_CARD);
+        tBalance += cardBalance;
+        tReconciled += cardReconciled;
+
+        // Accounts
+        m_frames["CASH_ACCOUNTS_INFO"] = account_stats.displayAccounts(cashBalance, cashReconciled, Model_Account::CASH);
+        tBalance += cashBalance;
+        tReconciled += cashReconciled;
+
+        m_frames["LOAN_ACCOUNTS_INFO"] = account_stats.displayAccounts(loanBalance, loanReconciled, Model_Account::LOAN);
+        tBalance += loanBalance;
+        tReconciled += loanReconciled;
+
+        m_frames["TERM_ACCOUNTS_INFO"] = account_stats.displayAccounts(termBalance, termReconciled, Model_Account::TERM);
+        tBalance += termBalance;
+        tReconciled += termReconciled;
+
+        //m_frames["ASSET_ACCOUNTS_INFO"] = account_stats.displayAccounts(assetBalance, Model_Account::ASSET);
+        //tBalance += assetBalance;
+
+        //m_frames["SHARE_ACCOUNTS_INFO"] = account_stats.displayAccounts(shareBalance, Model_Account::SHARES);
+        //tBalance += shareBalance;
+    }
 
     //Stocks
     htmlWidgetStocks stocks_widget;
-    m_frames["STOCKS_INFO"] = stocks_widget.getHTMLText();
-    tBalance += stocks_widget.get_total();
+    {
+        mmTrace::Scope trace("Home stocks");
+        m_frames["STOCKS_INFO"] = stocks_widget.getHTMLText();
+        tBalance += stocks_widget.get_total();
+    }
 
-    htmlWidgetAssets assets;
-    m_frames["ASSETS_INFO"] = assets.getHTMLText();
-    tBalance += Model_Asset::instance().balance();
+    double assetBalance = 0.0;
+    {
+        mmTrace::Scope trace("Home assets");
+        htmlWidgetAssets assets;
+        m_frames["ASSETS_INFO"] = assets.getHTMLText();
+        assetBalance = Model_Asset::instance().balance();
+        tBalance += assetBalance;
+    }
 
     htmlWidgetGrandTotals grand_totals;
     m_frames["GRAND_TOTAL"] = grand_totals.getHTMLText(tBalance, tReconciled
-                                                , Model_Asset::instance().balance(), stocks_widget.get_total());
+                                                , assetBalance, stocks_widget.get_total());
 
     //
-    htmlWidgetIncomeVsExpenses income_vs_expenses;
-    m_frames["INCOME_VS_EXPENSES"] = income_vs_expenses.getHTMLText();
+    {
+        mmTrace::Scope trace("Home income vs expenses");
+        htmlWidgetIncomeVsExpenses income_vs_expenses;
+        m_frames["INCOME_VS_EXPENSES"] = income_vs_expenses.getHTMLText();
+    }
     m_frames["INCOME_VS_EXPENSES_FORECOLOR"] = mmThemeMetaString(meta::COLOR_REPORT_FORECOLOR);
     m_frames["INCOME_VS_EXPENSES_COLORS"] = wxString::Format("'%s', '%s'", mmThemeMetaString(meta::COLOR_REPORT_CREDIT)
                                                 , mmThemeMetaString(meta::COLOR_REPORT_DEBIT));
 
-    htmlWidgetBillsAndDeposits bills_and_deposits(_("Upcoming Transactions"));
-    m_frames["BILLS_AND_DEPOSITS"] = bills_and_deposits.getHTMLText();
-
-    htmlWidgetTop7Categories top_trx;
-    m_frames["TOP_CATEGORIES"] = top_trx.getHTMLText();
-
-    htmlWidgetStatistics stat_widget;
-    m_frames["STATISTICS"] = stat_widget.getHTMLText();
+    {
+        mmTrace::Scope trace("Home upcoming transactions");
+        htmlWidgetBillsAndDeposits bills_and_deposits(_("Upcoming Transactions"));
+        m_frames["BILLS_AND_DEPOSITS"] = bills_and_deposits.getHTMLText();
+    }
+    {
+        mmTrace::Scope trace("Home top categories");
+        htmlWidgetTop7Categories top_trx;
+        m_frames["TOP_CATEGORIES"] = top_trx.getHTMLText();
+    }
+    {
+        mmTrace::Scope trace("Home statistics");
+        htmlWidgetStatistics stat_widget;
+        m_frames["STATISTICS"] = stat_widget.getHTMLText();
+    }
     m_frames["TOGGLES"] = getToggles();
 
+    mmTrace::Scope trace("Home currency rates");
     htmlWidgetCurrency currency_rates;
     m_frames["CURRENCY_RATES"] = currency_rates.getHtmlText();
 }
@@ -24,6 +24,7 @@
 #include "mmex.h"
 #include "mmframe.h"
 #include "mmcheckingpanel.h"
+#include "mmTrace.h"
 #include "paths.h"
 #include "platfdep.h"
 #include "sharetransactiondialog.h"
@@ -78,6 +79,7 @@ bool mmReportsPanel::Create(wxWindow *parent, wxWindowID winid
     , const wxPoint& pos, const wxSize& size, long style
     , const wxString& name)
 {
+    mmTrace::Scope trace("Report panel");
     SetExtraStyle(GetExtraStyle() | wxWS_EX_BLOCK_EVENTS);
     wxPanel::Create(parent, winid, pos, size, style, name);
 
@@ -92,7 +94,7 @@ bool mmReportsPanel::Create(wxWindow *parent, wxWindowID winid
     int id = rb_->getReportId();
     this->SetLabel(id < 0 ? "Custom Report" : rb_->getReportTitle(false));
 
-    Model_Usage::instance().pageview(this);
+    Model_Usage::instance().pageview(this, trace.elapsed());
 
     return TRUE;
 }
@@ -147,8 +149,15 @@ bool mmReportsPanel::saveReportText(bool initial)
 
     const auto time = wxDateTime::UNow();
 
-    const auto& name = getVFname4print("rep", rb_->getHTMLText());
-    browser_->LoadURL(name);
+    wxString html;
+    {
+        mmTrace::Scope trace(mmTrace::Intern("Report " + rb_->getReportTitle(false)));
+        html = rb_->getHTMLText();
+    }
+    {
+        mmTrace::Scope trace("Report render");
+        browser_->LoadURL(getVFname4print("rep", html));
+    }
 
     json_writer.Key("seconds");
     json_writer.Double((wxDateTime::UNow() - time).GetMilliseconds().ToDouble() / 1000);
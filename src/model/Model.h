@@ -19,11 +19,13 @@ Copyright (C) 2018 Stefano Giorgio (stef145g)
 #pragma once
 
 #include <vector>
+#include <set>
 #include <unordered_map>
 #include <algorithm>
 #include <wx/datetime.h>
 #include <wx/log.h>
 #include "db/DB_Table.h"
+#include "mmTrace.h"
 #include "singleton.h"
 
 class wxSQLite3Statement;
@@ -79,14 +81,7 @@ public:
 protected:
     static wxDate to_date(const wxString& str_date)
     {
-        static std::unordered_map<wxString, wxDate> cache;
-        const auto it = cache.find(str_date);
-        if (it != cache.end()) return it->second;
-
-        wxDate date;
-        date.ParseISODate(str_date); // the date in ISO 8601 format "YYYY-MM-DD".
-        cache.insert(std::make_pair(str_date, date));
-        return date;
+        return mmDate::FromISO(str_date).ToDateTime(); // the date in ISO 8601 format "YYYY-MM-DD".
     }
 
 public:
@@ -110,6 +105,7 @@ public:
     /** Return a list of Data record addresses (Data_Set) derived directly from the database. */
     const typename DB_TABLE::Data_Set all(COLUMN col = COLUMN(0), bool asc = true)
     {
+        mmTrace::Scope trace(trace_select());
         this->ensure(this->db_);
         return all(db_, col, asc);
     }
@@ -127,6 +123,7 @@ public:
     */
     const typename DB_TABLE::Data_Set find(const Args&... args)
     {
+        mmTrace::Scope trace(trace_select());
         return find_by(this, db_, true, args...);
     }
 
@@ -143,9 +140,22 @@ public:
     */
     const typename DB_TABLE::Data_Set find_or(const Args&... args)
     {
+        mmTrace::Scope trace(trace_select());
         return find_by(this, db_, false, args...);
     }
 
+    /**
+    all() for the large tables generated with a Row: the records are read into
+    a compact View instead of a Data_Set of full copies, see DB_View.
+    */
+    template<class TABLE = DB_TABLE>
+    const typename TABLE::View all_view(COLUMN col = COLUMN(0), bool asc = true)
+    {
+        mmTrace::Scope trace(trace_select());
+        this->ensure(this->db_);
+        return TABLE::all_view(db_, col, asc);
+    }
+
     /**
     * Return the Data record pointer for the given ID
     * from either memory cache or the database.
@@ -158,6 +168,7 @@ public:
     /** Save the Data record memory instance to the database. */
     int save(typename DB_TABLE::Data* r)
     {
+        mmTrace::Scope trace(trace_save());
         r->save(this->db_);
         return r->id();
     }
@@ -197,6 +208,115 @@ public:
         return this->remove(id, db_);
     }
 
+    /**
+    Return the records whose column col holds one of the keys,
+    read with one query per IN_CHUNK keys instead of one get() per key.
+    */
+    const typename DB_TABLE::Data_Set find_in(const wxString& col, const std::vector<int>& keys)
+    {
+        mmTrace::Scope trace(trace_select());
+        typename DB_TABLE::Data_Set result;
+        try
+        {
+            for (const auto& in : in_lists(keys))
+            {
+                wxSQLite3ResultSet q = db_->ExecuteQuery(this->query() + " WHERE " + col + " IN (" + in + ")");
+                while (q.NextRow())
+                    result.push_back(typename DB_TABLE::Data(q, this));
+                q.Finalize();
+            }
+        }
+        catch (const wxSQLite3Exception& e)
+        {
+            wxLogError("%s: Exception %s", this->name().utf8_str(), e.GetMessage().utf8_str());
+        }
+        return result;
+    }
+
+    /**
+    Delete the records whose column col holds one of the keys with set-based
+    statements, and_where optionally narrows the rows further.
+    * Returns the primary keys of the deleted records, their cached instances are released.
+    * A failing statement throws wxSQLite3Exception, the caller rolls back its savepoint.
+    */
+    std::vector<int> remove_in(const wxString& col, const std::vector<int>& keys, const wxString& and_where = "")
+    {
+        mmTrace::Scope trace(trace_save());
+        std::vector<int> removed;
+        for (const auto& in : in_lists(keys))
+        {
+            const wxString where = " WHERE " + col + " IN (" + in + ")"
+                + (and_where.empty() ? "" : " AND " + and_where);
+            wxSQLite3ResultSet q = db_->ExecuteQuery("SELECT " + DB_TABLE::PRIMARY::name() + " FROM " + this->name() + where);
+            while (q.NextRow())
+                removed.push_back(q.GetInt(0));
+            q.Finalize();
+            db_->ExecuteUpdate("DELETE FROM " + this->name() + where);
+        }
+        uncache(removed);
+        return removed;
+    }
+
+    /**
+    Re-read the cached records after set-based SQL changed their rows.
+    The cached instances are updated in place so outstanding pointers stay valid.
+    */
+    void refresh_cache(const std::vector<int>& ids)
+    {
+        std::vector<int> cached;
+        for (const auto id : ids)
+            if (this->index_by_id_.count(id)) cached.push_back(id);
+
+        for (auto& r : find_in(DB_TABLE::PRIMARY::name(), cached))
+            *this->index_by_id_[r.id()] = r;
+    }
+
+    /** Release the cached records of rows deleted by set-based SQL */
+    void uncache(const std::vector<int>& ids)
+    {
+        if (ids.empty()) return;
+        const std::set<int> gone(ids.begin(), ids.end());
+        typename DB_TABLE::Cache cache;
+        for (auto entity : this->cache_)
+        {
+            if (gone.count(entity->id()))
+            {
+                this->index_by_id_.erase(entity->id());
+                delete entity;
+            }
+            else
+                cache.push_back(entity);
+        }
+        this->cache_.swap(cache);
+    }
+
+protected:
+    /** Comma separated key lists for SQL IN clauses, short enough for the SQLite statement limits */
+    static std::vector<wxString> in_lists(const std::vector<int>& keys)
+    {
+        static const size_t IN_CHUNK = 500;
+        std::vector<wxString> lists;
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            if (i % IN_CHUNK == 0) lists.push_back(wxString());
+            lists.back() << (i % IN_CHUNK ? "," : "") << keys[i];
+        }
+        return lists;
+    }
+
+private:
+    /** Names under which this table's statements appear in the Diagnostics timings */
+    const char* trace_select() const
+    {
+        static const char* name = mmTrace::Intern("SQL select " + this->name());
+        return name;
+    }
+    const char* trace_save() const
+    {
+        static const char* name = mmTrace::Intern("SQL save " + this->name());
+        return name;
+    }
+
 public:
     void preload(int max_num = 1000)
     {
@@ -264,9 +264,7 @@ wxString Model_Account::toString(double value, const Data& r, int precision)
 
 Model_Account::STATUS_ENUM Model_Account::status(const Data* account)
 {
-    if (account->STATUS.CmpNoCase(all_status()[OPEN]) == 0)
-        return OPEN;
-    return CLOSED;
+    return account->STATUS.CmpNoCase(STATUS_CHOICES[OPEN].second) == 0 ? OPEN : CLOSED;
 }
 
 Model_Account::STATUS_ENUM Model_Account::status(const Data& account)
@@ -281,21 +279,29 @@ DB_Table_ACCOUNTLIST_V1::STATUS Model_Account::STATUS(STATUS_ENUM status, OP op)
 
 Model_Account::TYPE Model_Account::type(const Data* account)
 {
-    static std::unordered_map<wxString, TYPE> cache;
-    const auto it = cache.find(account->ACCOUNTTYPE);
-    if (it != cache.end()) return it->second;
-
-    for (const auto& t : TYPE_CHOICES) 
+    // the type names differ in their first letter, or the second for the C's,
+    // the whole name is still checked and anything else is CHECKING
+    const wxString& t = account->ACCOUNTTYPE;
+    if (t.length() < 2) return CHECKING;
+    TYPE type = CHECKING;
+    switch (t[0].GetValue())
     {
-        if (account->ACCOUNTTYPE.CmpNoCase(t.second) == 0)
+    case 'C': case 'c':
+        switch (t[1].GetValue())
         {
-            cache.insert(std::make_pair(account->ACCOUNTTYPE, t.first));
-            return t.first;
+        case 'A': case 'a': type = CASH; break;
+        case 'R': case 'r': type = CREDIT_CARD; break;
+        default: break;
         }
+        break;
+    case 'L': case 'l': type = LOAN; break;
+    case 'T': case 't': type = TERM; break;
+    case 'I': case 'i': type = INVESTMENT; break;
+    case 'A': case 'a': type = ASSET; break;
+    case 'S': case 's': type = SHARES; break;
+    default: return CHECKING;
     }
-
-    cache.insert(std::make_pair(account->ACCOUNTTYPE, TYPE::CHECKING));
-    return TYPE::CHECKING;
+    return t.CmpNoCase(TYPE_CHOICES[type].second) == 0 ? type : CHECKING;
 }
 
 Model_Account::TYPE Model_Account::type(const Data& account)
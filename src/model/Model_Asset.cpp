@@ -18,6 +18,7 @@
  ********************************************************/
 
 #include "Model_Asset.h"
+#include <cmath>
 #include "Model_Translink.h"
 
 const std::vector<std::pair<Model_Asset::RATE, wxString> > Model_Asset::RATE_CHOICES = 
@@ -125,9 +126,9 @@ wxArrayString Model_Asset::all_status()
 double Model_Asset::balance()
 {
     double balance = 0.0;
-    for (const auto& r: this->all())
+    for (const auto& item : valueAtDate(this->all(), wxDate::Today()))
     {
-        balance += value(r);
+        balance += item.second;
     }
     return balance;
 }
@@ -212,60 +213,97 @@ double Model_Asset::value(const Data& r)
     return instance().valueAtDate(&r, wxDate::Today());
 }
 
-double Model_Asset::valueAtDate(const Data* r, const wxDate date)
+namespace
 {
-    double balance = 0;
-    if (date >= STARTDATE(r)) {
-        Model_Translink::Data_Set translink_records = Model_Translink::instance().find(Model_Translink::LINKRECORDID(r->ASSETID), Model_Translink::LINKTYPE(Model_Attachment::reftype_desc(Model_Attachment::ASSET)));
-        if (!translink_records.empty())
+    /* (mmDate day number, amount) pairs contributing to an asset's value */
+    typedef std::vector<std::pair<int, double> > Flows;
+
+    void addFlow(Flows& flows, const Model_Translink::Data& link)
+    {
+        const Model_Checking::Data* tran = Model_Checking::instance().get(link.CHECKINGACCOUNTID);
+        if (!tran || tran->TRANSID != link.CHECKINGACCOUNTID) return;
+        flows.emplace_back(tran->TRANSDATE_date().GetValue(), -1 * Model_Checking::balance(tran, tran->ACCOUNTID));
+    }
+
+    /*
+    Evaluate the asset at each of the ascending day numbers in a single pass.
+    The running balance is carried forward by growth^(days elapsed), so pow()
+    is called once per date and once per flow rather than once per pair.
+    */
+    void valueSeries(const Model_Asset::Data* r, Flows& flows, const std::vector<int>& days, double* values)
+    {
+        double growth = 1.0;
+        switch (Model_Asset::rate(r))
         {
-            for (const auto& link : translink_records)
-            {
-                const Model_Checking::Data* tran = Model_Checking::instance().get(link.CHECKINGACCOUNTID);
-                const wxDate tranDate = Model_Checking::TRANSDATE(tran);
-                if (tranDate <= date)
-                {
-                    double sum = -1 * Model_Checking::balance(tran, tran->ACCOUNTID);
-                    wxTimeSpan diff_time = date - tranDate;
-                    double diff_time_in_days = static_cast<double>(diff_time.GetDays());
-
-                    switch (rate(r))
-                    {
-                    case RATE_NONE:
-                        break;
-                    case RATE_APPRECIATE:
-                        sum *= pow(1.0 + (r->VALUECHANGERATE / 36500.0), diff_time_in_days);
-                        break;
-                    case RATE_DEPRECIATE:
-                        sum *= pow(1.0 - (r->VALUECHANGERATE / 36500.0), diff_time_in_days);
-                        break;
-                    default:
-                        break;
-                    }
-
-                    balance += sum;
-                }
-            }
+        case Model_Asset::RATE_APPRECIATE:
+            growth += r->VALUECHANGERATE / 36500.0;
+            break;
+        case Model_Asset::RATE_DEPRECIATE:
+            growth -= r->VALUECHANGERATE / 36500.0;
+            break;
+        default:
+            break;
         }
-        else {
-            balance = r->VALUE;
-            wxTimeSpan diff_time = date - STARTDATE(r);
-            double diff_time_in_days = static_cast<double>(diff_time.GetDays());
-
-            switch (rate(r))
-            {
-            case RATE_NONE:
-                break;
-            case RATE_APPRECIATE:
-                balance *= pow(1.0 + (r->VALUECHANGERATE / 36500.0), diff_time_in_days);
-                break;
-            case RATE_DEPRECIATE:
-                balance *= pow(1.0 - (r->VALUECHANGERATE / 36500.0), diff_time_in_days);
-                break;
-            default:
-                break;
-            }
+
+        const int start = r->STARTDATE_date().GetValue();
+        if (flows.empty())
+            flows.emplace_back(start, r->VALUE);
+        std::sort(flows.begin(), flows.end());
+
+        auto flow = flows.begin();
+        double balance = 0.0;
+        for (size_t i = 0; i < days.size(); ++i)
+        {
+            if (i > 0 && balance != 0.0 && growth != 1.0)
+                balance *= pow(growth, days[i] - days[i - 1]);
+            for (; flow != flows.end() && flow->first <= days[i]; ++flow)
+                balance += flow->second * pow(growth, days[i] - flow->first);
+            values[i] = days[i] >= start ? balance : 0.0;
         }
     }
+}
+
+double Model_Asset::valueAtDate(const Data* r, const wxDate date)
+{
+    Flows flows;
+    for (const auto& link : Model_Translink::instance().find(Model_Translink::LINKRECORDID(r->ASSETID), Model_Translink::LINKTYPE(Model_Attachment::reftype_desc(Model_Attachment::ASSET))))
+        addFlow(flows, link);
+
+    double balance = 0.0;
+    valueSeries(r, flows, { mmDate(date).GetValue() }, &balance);
     return balance;
-}
\ No newline at end of file
+}
+
+std::vector<std::vector<double> > Model_Asset::valueAtDates(const Data_Set& assets, const std::vector<wxDate>& dates)
+{
+    wxASSERT(std::is_sorted(dates.begin(), dates.end()));
+
+    std::vector<int> days;
+    days.reserve(dates.size());
+    for (const auto& date : dates) days.push_back(mmDate(date).GetValue());
+
+    std::map<int, Flows> flows;
+    for (const auto& asset : assets) flows[asset.ASSETID];
+    for (const auto& link : Model_Translink::instance().find(Model_Translink::LINKTYPE(Model_Attachment::reftype_desc(Model_Attachment::ASSET))))
+    {
+        const auto it = flows.find(link.LINKRECORDID);
+        if (it != flows.end()) addFlow(it->second, link);
+    }
+
+    std::vector<std::vector<double> > values(assets.size(), std::vector<double>(dates.size(), 0.0));
+    for (size_t i = 0; i < assets.size(); ++i)
+    {
+        if (dates.empty()) break;
+        valueSeries(&assets[i], flows[assets[i].ASSETID], days, values[i].data());
+    }
+    return values;
+}
+
+std::map<int, double> Model_Asset::valueAtDate(const Data_Set& assets, const wxDate& date)
+{
+    const auto values = valueAtDates(assets, { date });
+    std::map<int, double> result;
+    for (size_t i = 0; i < assets.size(); ++i)
+        result[assets[i].ASSETID] = values[i][0];
+    return result;
+}
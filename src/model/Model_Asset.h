@@ -20,6 +20,7 @@
 #ifndef MODEL_ASSET_H
 #define MODEL_ASSET_H
 
+#include <map>
 #include "Model.h"
 #include "db/DB_Table_Assets_V1.h"
 #include "Model_Currency.h" // detect base currency
@@ -95,6 +96,13 @@ public:
     static double value(const Data& r);
     /** Returns the calculated value at a given date */
     double valueAtDate(const Data* r, const wxDate date);
+    /** Returns the calculated value of each asset at a given date, keyed by ASSETID */
+    std::map<int, double> valueAtDate(const Data_Set& assets, const wxDate& date);
+    /**
+    Returns the calculated values as result[asset][date] for dates in ascending order.
+    All asset transaction links are read in one query and each asset is evaluated in a single pass.
+    */
+    std::vector<std::vector<double> > valueAtDates(const Data_Set& assets, const std::vector<wxDate>& dates);
 };
 
 #endif // 
@@ -85,6 +85,12 @@ int Model_Attachment::NrAttachments(const wxString& RefType, const int RefId)
     return Model_Attachment::instance().find(Model_Attachment::DB_Table_ATTACHMENT_V1::REFTYPE(RefType), Model_Attachment::REFID(RefId)).size();
 }
 
+/** Return the number of attachments sharing the stored file */
+int Model_Attachment::RefCount(const wxString& RefType, const wxString& FileName)
+{
+    return Model_Attachment::instance().find(Model_Attachment::DB_Table_ATTACHMENT_V1::REFTYPE(RefType), Model_Attachment::FILENAME(FileName)).size();
+}
+
 /** Return the last attachment number linked to a specific object */
 int Model_Attachment::LastAttachmentNumber(const wxString& RefType, const int RefId)
 {
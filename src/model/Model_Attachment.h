@@ -59,6 +59,9 @@ public:
     /** Return the number of attachments linked to a specific object */
     static int NrAttachments(const wxString& RefType, const int RefId);
 
+    /** Return the number of attachments sharing the stored file */
+    static int RefCount(const wxString& RefType, const wxString& FileName);
+
     /** Return the last attachment number linked to a specific object */
     static int LastAttachmentNumber(const wxString& RefType, const int RefId);
 
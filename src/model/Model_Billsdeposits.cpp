@@ -113,21 +113,19 @@ wxDate Model_Billsdeposits::NEXTOCCURRENCEDATE(const Data& r)
 
 Model_Billsdeposits::TYPE Model_Billsdeposits::type(const wxString& r)
 {
-    static std::unordered_map<wxString, TYPE> cache;
-    const auto it = cache.find(r);
-    if (it != cache.end()) return it->second;
-
-    for (const auto& t : TYPE_CHOICES)
+    // Withdrawal, Deposit and Transfer differ in their first letter,
+    // the whole name is still checked and anything else is a withdrawal
+    TYPE type = WITHDRAWAL;
+    if (!r.empty())
     {
-        if (r.CmpNoCase(t.second) == 0)
+        switch (r[0].GetValue())
         {
-            cache.insert(std::make_pair(r, t.first));
-            return t.first;
+        case 'D': case 'd': type = DEPOSIT; break;
+        case 'T': case 't': type = TRANSFER; break;
+        default: break;
         }
     }
-
-    cache.insert(std::make_pair(r, WITHDRAWAL));
-    return WITHDRAWAL;
+    return r.CmpNoCase(TYPE_CHOICES[type].second) == 0 ? type : WITHDRAWAL;
 }
 Model_Billsdeposits::TYPE Model_Billsdeposits::type(const Data& r)
 {
@@ -139,27 +137,21 @@ Model_Billsdeposits::TYPE Model_Billsdeposits::type(const Data* r)
 }
 Model_Billsdeposits::STATUS_ENUM Model_Billsdeposits::status(const wxString& r)
 {
-    static std::unordered_map<wxString, STATUS_ENUM> cache;
-    const auto it = cache.find(r);
-    if (it != cache.end()) return it->second;
-
-    for (const auto & s : STATUS_ENUM_CHOICES)
+    // the short codes R, V, F, D are the first letters of the full names,
+    // both forms decode the same, anything else is NONE
+    STATUS_ENUM status = NONE;
+    if (!r.empty())
     {
-        if (r.CmpNoCase(s.second) == 0)
+        switch (r[0].GetValue())
         {
-            cache.insert(std::make_pair(r, s.first));
-            return s.first;
+        case 'R': case 'r': status = RECONCILED; break;
+        case 'V': case 'v': status = VOID_; break;
+        case 'F': case 'f': status = FOLLOWUP; break;
+        case 'D': case 'd': status = DUPLICATE_; break;
+        default: return NONE;
         }
     }
-
-    STATUS_ENUM ret = NONE;
-    if (r.CmpNoCase("R") == 0) ret = RECONCILED;
-    else if (r.CmpNoCase("V") == 0) ret = VOID_;
-    else if (r.CmpNoCase("F") == 0) ret = FOLLOWUP;
-    else if (r.CmpNoCase("D") == 0) ret = DUPLICATE_;
-    cache.insert(std::make_pair(r, ret));
-
-    return ret;
+    return r.length() == 1 || r.CmpNoCase(STATUS_ENUM_CHOICES[status].second) == 0 ? status : NONE;
 }
 Model_Billsdeposits::STATUS_ENUM Model_Billsdeposits::status(const Data& r)
 {
@@ -172,9 +164,9 @@ Model_Billsdeposits::STATUS_ENUM Model_Billsdeposits::status(const Data* r)
 
 wxString Model_Billsdeposits::toShortStatus(const wxString& fullStatus)
 {
-    wxString s = fullStatus.Left(1);
-    s.Replace("U", "");
-    return s;
+    // "Unreconciled" is stored as ""
+    if (fullStatus.empty() || fullStatus[0] == 'U') return wxEmptyString;
+    return fullStatus.Left(1);
 }
 
 /**
@@ -280,7 +272,7 @@ bool Model_Billsdeposits::AllowTransaction(const Data& r, AccountBalance& bal)
 
     double new_value = r.TRANSAMOUNT;
 
-    if (r.TRANSCODE == Model_Checking::all_type()[Model_Checking::WITHDRAWAL])
+    if (r.TRANSCODE == Model_Checking::WITHDRAWAL_STR)
     {
         new_value *= -1;
     }
@@ -343,37 +335,7 @@ void Model_Billsdeposits::completeBDInSeries(int bdID)
     Data* bill = get(bdID);
     if (bill)
     {
-        int repeats = bill->REPEATS;
-        // DeMultiplex the Auto Executable fields.
-        if (repeats >= BD_REPEATS_MULTIPLEX_BASE)    // Auto Execute User Acknowlegement required
-            repeats -= BD_REPEATS_MULTIPLEX_BASE;
-        if (repeats >= BD_REPEATS_MULTIPLEX_BASE)    // Auto Execute Silent mode
-            repeats -= BD_REPEATS_MULTIPLEX_BASE;
-        int numRepeats = bill->NUMOCCURRENCES;
-        const wxDateTime& payment_date_current = TRANSDATE(bill);
-        const wxDateTime& payment_date_update = nextOccurDate(repeats, numRepeats, payment_date_current);
-
-        const wxDateTime& due_date_current = NEXTOCCURRENCEDATE(bill);
-        const wxDateTime& due_date_update = nextOccurDate(repeats, numRepeats, due_date_current);
-
-        if (numRepeats != REPEAT_TYPE::REPEAT_INACTIVE)
-        {
-            if ((repeats < REPEAT_TYPE::REPEAT_IN_X_DAYS) || (repeats > REPEAT_TYPE::REPEAT_EVERY_X_MONTHS))
-                numRepeats--;
-        }
-
-        if (repeats == REPEAT_TYPE::REPEAT_NONE)
-            numRepeats = 0;
-        else if ((repeats == REPEAT_TYPE::REPEAT_IN_X_DAYS)
-            || (repeats == REPEAT_TYPE::REPEAT_IN_X_MONTHS))
-        {
-            if (numRepeats != -1) numRepeats = -1;
-        }
-
-        bill->NEXTOCCURRENCEDATE = due_date_update.FormatISODate();
-        bill->TRANSDATE = payment_date_update.FormatISODate();
-
-        bill->NUMOCCURRENCES = numRepeats;
+        advanceInSeries(*bill);
         save(bill);
 
         if (bill->NUMOCCURRENCES == REPEAT_TYPE::REPEAT_NONE)
@@ -384,6 +346,41 @@ void Model_Billsdeposits::completeBDInSeries(int bdID)
     }
 }
 
+void Model_Billsdeposits::advanceInSeries(Data& bill)
+{
+    int repeats = bill.REPEATS;
+    // DeMultiplex the Auto Executable fields.
+    if (repeats >= BD_REPEATS_MULTIPLEX_BASE)    // Auto Execute User Acknowlegement required
+        repeats -= BD_REPEATS_MULTIPLEX_BASE;
+    if (repeats >= BD_REPEATS_MULTIPLEX_BASE)    // Auto Execute Silent mode
+        repeats -= BD_REPEATS_MULTIPLEX_BASE;
+    int numRepeats = bill.NUMOCCURRENCES;
+    const wxDateTime& payment_date_current = TRANSDATE(bill);
+    const wxDateTime& payment_date_update = nextOccurDate(repeats, numRepeats, payment_date_current);
+
+    const wxDateTime& due_date_current = NEXTOCCURRENCEDATE(bill);
+    const wxDateTime& due_date_update = nextOccurDate(repeats, numRepeats, due_date_current);
+
+    if (numRepeats != REPEAT_TYPE::REPEAT_INACTIVE)
+    {
+        if ((repeats < REPEAT_TYPE::REPEAT_IN_X_DAYS) || (repeats > REPEAT_TYPE::REPEAT_EVERY_X_MONTHS))
+            numRepeats--;
+    }
+
+    if (repeats == REPEAT_TYPE::REPEAT_NONE)
+        numRepeats = 0;
+    else if ((repeats == REPEAT_TYPE::REPEAT_IN_X_DAYS)
+        || (repeats == REPEAT_TYPE::REPEAT_IN_X_MONTHS))
+    {
+        if (numRepeats != -1) numRepeats = -1;
+    }
+
+    bill.NEXTOCCURRENCEDATE = due_date_update.FormatISODate();
+    bill.TRANSDATE = payment_date_update.FormatISODate();
+
+    bill.NUMOCCURRENCES = numRepeats;
+}
+
 const wxDateTime Model_Billsdeposits::nextOccurDate(int repeatsType, int numRepeats, wxDateTime nextOccurDate, bool reverse)
 {
     int k = reverse ? -1 : 1;
@@ -168,6 +168,8 @@ public:
     static const Model_Budgetsplittransaction::Data_Set splittransaction(const Data& r);
 
     void completeBDInSeries(int bdID);
+    /** Move the dates and the remaining count of the schedule to its next occurrence, without saving */
+    static void advanceInSeries(Data& bill);
     static const wxDateTime nextOccurDate(int type, int numRepeats, wxDateTime nextOccurDate, bool reverse = false);
 };
 
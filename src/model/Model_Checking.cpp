@@ -18,10 +18,13 @@
  ********************************************************/
 
 #include "option.h"
+#include "autocomplete.h"
 #include "Model_Checking.h"
 #include "Model_Account.h"
 #include "Model_Payee.h"
 #include "Model_Category.h"
+#include "Model_CurrencyHistory.h"
+#include "Model_Shareinfo.h"
 #include <queue>
 #include "Model_Translink.h"
 
@@ -99,6 +102,197 @@ bool Model_Checking::remove(int id)
     return this->remove(id, db_);
 }
 
+namespace
+{
+    /* Revalue each asset or stock linked to the transactions once, after their links changed */
+    void UpdateLinkedValues(const Model_Translink::Data_Set& links)
+    {
+        std::set<std::pair<wxString, int> > records;
+        for (const auto& link : links)
+            records.insert(std::make_pair(link.LINKTYPE, link.LINKRECORDID));
+
+        for (const auto& record : records)
+        {
+            if (record.first == Model_Attachment::reftype_desc(Model_Attachment::ASSET))
+            {
+                Model_Asset::Data* asset = Model_Asset::instance().get(record.second);
+                if (asset && asset->ASSETID == record.second) Model_Translink::UpdateAssetValue(asset);
+            }
+            else if (record.first == Model_Attachment::reftype_desc(Model_Attachment::STOCK))
+            {
+                Model_Stock::Data* stock = Model_Stock::instance().get(record.second);
+                if (stock && stock->STOCKID == record.second) Model_Translink::UpdateStockValue(stock);
+            }
+        }
+    }
+}
+
+std::vector<int> Model_Checking::update(const std::vector<int>& ids, const Bulk_Edit& edit)
+{
+    const bool amounts_changed = edit.amount || edit.type || edit.to_account;
+
+    // Row checks need the current values, read them all at once
+    std::vector<int> changed, same_amount;
+    std::vector<std::pair<int, double> > converted;
+    for (const auto& trx : find_in(PRIMARY::name(), ids))
+    {
+        if (is_locked(&trx)) continue;
+
+        Data r = trx;
+        if (edit.payee) r.TOACCOUNTID = -1;
+        if (edit.to_account) r.TOACCOUNTID = edit.TOACCOUNTID;
+        if (edit.date)
+        {
+            const Model_Account::Data* account = Model_Account::instance().get(r.ACCOUNTID);
+            const Model_Account::Data* to_account = Model_Account::instance().get(r.TOACCOUNTID);
+            if ((account && edit.TRANSDATE < account->INITIALDATE)
+                || (to_account && edit.TRANSDATE < to_account->INITIALDATE))
+                continue;
+            r.TRANSDATE = edit.TRANSDATE;
+        }
+        changed.push_back(r.TRANSID);
+
+        if (!amounts_changed) continue;
+        if (edit.amount) r.TRANSAMOUNT = edit.TRANSAMOUNT;
+        if (edit.type) r.TRANSCODE = edit.TRANSCODE;
+
+        // Only transfers between currencies keep their own TOTRANSAMOUNT
+        const Model_Account::Data* account = Model_Account::instance().get(r.ACCOUNTID);
+        const Model_Account::Data* to_account = is_transfer(&r) ? Model_Account::instance().get(r.TOACCOUNTID) : nullptr;
+        if (!account || !to_account || account->CURRENCYID == to_account->CURRENCYID)
+        {
+            same_amount.push_back(r.TRANSID);
+            continue;
+        }
+
+        double exch = 1;
+        const double convRateTo = Model_CurrencyHistory::getDayRate(to_account->CURRENCYID, r.TRANSDATE);
+        if (convRateTo > 0)
+        {
+            const double convRate = Model_CurrencyHistory::getDayRate(account->CURRENCYID, r.TRANSDATE);
+            exch = convRate / convRateTo;
+        }
+        converted.push_back(std::make_pair(r.TRANSID, r.TRANSAMOUNT * exch));
+    }
+
+    wxArrayString set;
+    if (edit.status) set.Add("STATUS = :status");
+    if (edit.type) set.Add("TRANSCODE = :type");
+    if (edit.amount) set.Add("TRANSAMOUNT = :amount");
+    if (edit.payee) set.Add("PAYEEID = :payee, TOACCOUNTID = -1");
+    if (edit.to_account) set.Add("TOACCOUNTID = :to_account, PAYEEID = -1");
+    if (edit.date) set.Add("TRANSDATE = :date");
+    if (edit.color) set.Add("FOLLOWUPID = :color");
+    if (edit.category) set.Add("CATEGID = :category");
+    if (edit.notes) set.Add(edit.append_notes
+        ? "NOTES = ifnull(NOTES, '') || CASE WHEN ifnull(NOTES, '') = '' OR substr(NOTES, -1) = char(10) THEN '' ELSE char(10) END || :notes"
+        : "NOTES = :notes");
+
+    this->Savepoint("MMEX_Bulk");
+    try
+    {
+        for (const auto& in : in_lists(changed))
+        {
+            if (set.empty()) break;
+            wxSQLite3Statement stmt = db_->PrepareStatement("UPDATE CHECKINGACCOUNT_V1 SET "
+                + wxJoin(set, ',', '\0') + " WHERE TRANSID IN (" + in + ")");
+            if (edit.status) stmt.Bind(stmt.GetParamIndex(":status"), edit.STATUS);
+            if (edit.type) stmt.Bind(stmt.GetParamIndex(":type"), edit.TRANSCODE);
+            if (edit.amount) stmt.Bind(stmt.GetParamIndex(":amount"), edit.TRANSAMOUNT);
+            if (edit.payee) stmt.Bind(stmt.GetParamIndex(":payee"), edit.PAYEEID);
+            if (edit.to_account) stmt.Bind(stmt.GetParamIndex(":to_account"), edit.TOACCOUNTID);
+            if (edit.date) stmt.Bind(stmt.GetParamIndex(":date"), edit.TRANSDATE);
+            if (edit.color) stmt.Bind(stmt.GetParamIndex(":color"), edit.FOLLOWUPID);
+            if (edit.category) stmt.Bind(stmt.GetParamIndex(":category"), edit.CATEGID);
+            if (edit.notes) stmt.Bind(stmt.GetParamIndex(":notes"), edit.NOTES);
+            stmt.ExecuteUpdate();
+            stmt.Finalize();
+        }
+
+        for (const auto& in : in_lists(same_amount))
+            db_->ExecuteUpdate("UPDATE CHECKINGACCOUNT_V1 SET TOTRANSAMOUNT = TRANSAMOUNT WHERE TRANSID IN (" + in + ")");
+
+        if (!converted.empty())
+        {
+            wxSQLite3Statement stmt = db_->PrepareStatement("UPDATE CHECKINGACCOUNT_V1 SET TOTRANSAMOUNT = ? WHERE TRANSID = ?");
+            for (const auto& item : converted)
+            {
+                stmt.Bind(1, item.second);
+                stmt.Bind(2, item.first);
+                stmt.ExecuteUpdate();
+                stmt.Reset();
+            }
+            stmt.Finalize();
+        }
+    }
+    catch (const wxSQLite3Exception&)
+    {
+        this->Rollback("MMEX_Bulk");
+        this->ReleaseSavepoint("MMEX_Bulk");
+        throw;
+    }
+    this->ReleaseSavepoint("MMEX_Bulk");
+
+    refresh_cache(changed);
+    return changed;
+}
+
+std::vector<int> Model_Checking::trash(const std::vector<int>& ids, const wxString& deletion_time)
+{
+    std::vector<int> changed;
+    this->Savepoint("MMEX_Bulk");
+    try
+    {
+        for (const auto& in : in_lists(ids))
+        {
+            wxSQLite3ResultSet q = db_->ExecuteQuery("SELECT TRANSID FROM CHECKINGACCOUNT_V1 WHERE TRANSID IN (" + in + ")");
+            while (q.NextRow()) changed.push_back(q.GetInt(0));
+            q.Finalize();
+
+            wxSQLite3Statement stmt = db_->PrepareStatement("UPDATE CHECKINGACCOUNT_V1 SET DELETEDTIME = ? WHERE TRANSID IN (" + in + ")");
+            stmt.Bind(1, deletion_time);
+            stmt.ExecuteUpdate();
+            stmt.Finalize();
+        }
+    }
+    catch (const wxSQLite3Exception&)
+    {
+        this->Rollback("MMEX_Bulk");
+        this->ReleaseSavepoint("MMEX_Bulk");
+        throw;
+    }
+    this->ReleaseSavepoint("MMEX_Bulk");
+
+    refresh_cache(changed);
+    UpdateLinkedValues(Model_Translink::instance().find_in(Model_Translink::CHECKINGACCOUNTID::name(), changed));
+    return changed;
+}
+
+std::vector<int> Model_Checking::remove(const std::vector<int>& ids)
+{
+    const auto links = Model_Translink::instance().find_in(Model_Translink::CHECKINGACCOUNTID::name(), ids);
+
+    std::vector<int> removed;
+    this->Savepoint("MMEX_Bulk");
+    try
+    {
+        Model_Splittransaction::instance().remove_in(Model_Splittransaction::TRANSID::name(), ids);
+        Model_Shareinfo::instance().remove_in(Model_Shareinfo::CHECKINGACCOUNTID::name(), ids);
+        Model_Translink::instance().remove_in(Model_Translink::CHECKINGACCOUNTID::name(), ids);
+        removed = remove_in(PRIMARY::name(), ids);
+    }
+    catch (const wxSQLite3Exception&)
+    {
+        this->Rollback("MMEX_Bulk");
+        this->ReleaseSavepoint("MMEX_Bulk");
+        throw;
+    }
+    this->ReleaseSavepoint("MMEX_Bulk");
+
+    UpdateLinkedValues(links);
+    return removed;
+}
+
 const Model_Splittransaction::Data_Set Model_Checking::splittransaction(const Data* r)
 {
     return Model_Splittransaction::instance().find(Model_Splittransaction::TRANSID(r->TRANSID));
@@ -146,22 +340,19 @@ wxDate Model_Checking::TRANSDATE(const Data& r)
 
 Model_Checking::TYPE Model_Checking::type(const wxString& r)
 {
-    if (r.empty()) return TYPE::WITHDRAWAL;
-    static std::unordered_map<wxString, TYPE> cache;
-    const auto it = cache.find(r);
-    if (it != cache.end()) return it->second;
-
-    for (const auto& t : TYPE_CHOICES)
+    // Withdrawal, Deposit and Transfer differ in their first letter,
+    // the whole name is still checked and anything else is a withdrawal
+    TYPE type = WITHDRAWAL;
+    if (!r.empty())
     {
-        if (r.CmpNoCase(t.second) == 0)
+        switch (r[0].GetValue())
         {
-            cache.insert(std::make_pair(r, t.first));
-            return t.first;
+        case 'D': case 'd': type = DEPOSIT; break;
+        case 'T': case 't': type = TRANSFER; break;
+        default: break;
         }
     }
-
-    cache.insert(std::make_pair(r, TYPE::WITHDRAWAL));
-    return TYPE::WITHDRAWAL;
+    return r.CmpNoCase(TYPE_CHOICES[type].second) == 0 ? type : WITHDRAWAL;
 }
 Model_Checking::TYPE Model_Checking::type(const Data& r)
 {
@@ -174,27 +365,21 @@ Model_Checking::TYPE Model_Checking::type(const Data* r)
 
 Model_Checking::STATUS_ENUM Model_Checking::status(const wxString& r)
 {
-    static std::unordered_map<wxString, STATUS_ENUM> cache;
-    const auto it = cache.find(r);
-    if (it != cache.end()) return it->second;
-
-    for (const auto & s : STATUS_ENUM_CHOICES)
+    // the short codes R, V, F, D are the first letters of the full names,
+    // both forms decode the same, anything else is NONE
+    STATUS_ENUM status = NONE;
+    if (!r.empty())
     {
-        if (r.CmpNoCase(s.second) == 0)
+        switch (r[0].GetValue())
         {
-            cache.insert(std::make_pair(r, s.first));
-            return s.first;
+        case 'R': case 'r': status = RECONCILED; break;
+        case 'V': case 'v': status = VOID_; break;
+        case 'F': case 'f': status = FOLLOWUP; break;
+        case 'D': case 'd': status = DUPLICATE_; break;
+        default: return NONE;
         }
     }
-
-    STATUS_ENUM ret = NONE;
-    if (r.CmpNoCase("R") == 0) ret = RECONCILED;
-    else if (r.CmpNoCase("V") == 0) ret = VOID_;
-    else if (r.CmpNoCase("F") == 0) ret = FOLLOWUP;
-    else if (r.CmpNoCase("D") == 0) ret = DUPLICATE_;
-    cache.insert(std::make_pair(r, ret));
-
-    return ret;
+    return r.length() == 1 || r.CmpNoCase(STATUS_ENUM_CHOICES[status].second) == 0 ? status : NONE;
 }
 Model_Checking::STATUS_ENUM Model_Checking::status(const Data& r)
 {
@@ -278,21 +463,12 @@ double Model_Checking::reconciled(const Data& r, int account_id)
 
 bool Model_Checking::is_locked(const Data* r)
 {
-    bool val = false;
     Model_Account::Data* acc = Model_Account::instance().get(r->ACCOUNTID);
+    if (!Model_Account::BoolOf(acc->STATEMENTLOCKED))
+        return false;
 
-    if (Model_Account::BoolOf(acc->STATEMENTLOCKED))
-    {
-        wxDateTime transaction_date;
-        if (transaction_date.ParseDate(r->TRANSDATE))
-        {
-            if (transaction_date <= Model_Account::DateOf(acc->STATEMENTDATE))
-            {
-                val = true;
-            }
-        }
-    }
-    return val;
+    const mmDate transaction_date = r->TRANSDATE_date();
+    return transaction_date.IsValid() && transaction_date <= acc->STATEMENTDATE_date();
 }
 
 
@@ -315,9 +491,9 @@ bool Model_Checking::is_deposit(const Data* r)
 
 wxString Model_Checking::toShortStatus(const wxString& fullStatus)
 {
-    wxString s = fullStatus.Left(1);
-    s.Replace("U", "");
-    return s;
+    // "Unreconciled" is stored as ""
+    if (fullStatus.empty() || fullStatus[0] == 'U') return wxEmptyString;
+    return fullStatus.Left(1);
 }
 
 Model_Checking::Full_Data::Full_Data()
@@ -439,7 +615,7 @@ const wxString Model_Checking::Full_Data::get_account_name(int account_id) const
 
 bool Model_Checking::Full_Data::is_foreign() const
 {
-    return (this->TOACCOUNTID > 0) && ((this->TRANSCODE == all_type()[DEPOSIT]) || (this->TRANSCODE == all_type()[WITHDRAWAL]));
+    return (this->TOACCOUNTID > 0) && ((this->TRANSCODE == DEPOSIT_STR) || (this->TRANSCODE == WITHDRAWAL_STR));
 }
 
 bool Model_Checking::Full_Data::is_foreign_transfer() const
@@ -455,50 +631,9 @@ wxString Model_Checking::Full_Data::info() const
     return info;
 }
 
-bool CompareUsedNotes(const std::tuple<int, wxString, wxString>& a, const std::tuple<int, wxString, wxString>& b)
-{
-    if (std::get<0>(a) < std::get<0>(b)) return true;
-    if (std::get<0>(b) < std::get<0>(a)) return false;
-
-    // a=b for primary condition, go to secondary (but reverse order)
-    if (std::get<1>(a) > std::get<1>(b)) return true;
-    if (std::get<1>(b) > std::get<1>(a)) return false;
-
-    return false;
-}
-
 void Model_Checking::getFrequentUsedNotes(std::vector<wxString> &frequentNotes, int accountID)
 {
-    frequentNotes.clear();
-    size_t max = 20;
-
-    const auto notes = instance().find(NOTES("", NOT_EQUAL)
-        , accountID > 0 ? ACCOUNTID(accountID) : ACCOUNTID(-1, NOT_EQUAL));
-
-    // Count frequency
-    std::map <wxString, std::pair<int, wxString> > counterMap;
-    for (const auto& entry : notes)
-    {
-        counterMap[entry.NOTES].first--;
-        if (entry.TRANSDATE > counterMap[entry.NOTES].second)
-            counterMap[entry.NOTES].second = entry.TRANSDATE;
-    }
-
-    // Convert to vector
-    std::vector<std::tuple<int, wxString, wxString> > vec;
-    for (const auto& entry : counterMap)
-        vec.push_back(std::make_tuple(entry.second.first, entry.second.second, entry.first));
-
-    // Sort by frequency then date
-    std::sort(vec.begin(), vec.end(), CompareUsedNotes);
-
-    // Pull out top 20 (max)
-    for (const auto& kv : vec)
-    {
-        if (0 == max--)
-            break;
-        frequentNotes.push_back(std::get<2>(kv));
-    }
+    mmAutoComplete::instance().FrequentNotes(frequentNotes, accountID);
 }
 
 void Model_Checking::getEmptyTransaction(Data &data, int accountID)
@@ -627,7 +762,7 @@ const wxString Model_Checking::Full_Data::to_json()
 
 bool Model_Checking::foreignTransaction(const Data& data)
 {
-    return (data.TOACCOUNTID > 0) && ((data.TRANSCODE == all_type()[DEPOSIT]) || (data.TRANSCODE == all_type()[WITHDRAWAL]));
+    return (data.TOACCOUNTID > 0) && ((data.TRANSCODE == DEPOSIT_STR) || (data.TRANSCODE == WITHDRAWAL_STR));
 }
 
 bool Model_Checking::foreignTransactionAsTransfer(const Data& data)
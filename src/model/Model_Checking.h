@@ -148,6 +148,43 @@ public:
 public:
     bool remove(int id);
 
+    /** Column changes for update(); a column is only written when its flag is set */
+    struct Bulk_Edit
+    {
+        bool status = false;
+        wxString STATUS;
+        bool type = false;
+        wxString TRANSCODE;
+        bool amount = false;
+        double TRANSAMOUNT = 0;
+        bool payee = false;         // also clears TOACCOUNTID
+        int PAYEEID = -1;
+        bool to_account = false;    // also clears PAYEEID
+        int TOACCOUNTID = -1;
+        bool date = false;          // rows dated before an account's initial date are skipped
+        wxString TRANSDATE;
+        bool color = false;
+        int FOLLOWUPID = -1;
+        bool category = false;
+        int CATEGID = -1;
+        bool notes = false;
+        bool append_notes = false;
+        wxString NOTES;
+    };
+
+    /*
+    Bulk mutations run a few set-based statements per call instead of one
+    save() or remove() per transaction, and refresh the cache once.
+    Each returns the ids actually changed, so the caller can notify the UI once.
+    On a failing statement the changes are rolled back and the wxSQLite3Exception is rethrown.
+    */
+    /** Apply the edit to every unlocked transaction */
+    std::vector<int> update(const std::vector<int>& ids, const Bulk_Edit& edit);
+    /** Move the transactions to the Deleted Transactions view */
+    std::vector<int> trash(const std::vector<int>& ids, const wxString& deletion_time);
+    /** Permanently delete the transactions with their splits, share entries and links */
+    std::vector<int> remove(const std::vector<int>& ids);
+
 public:
     static const Model_Splittransaction::Data_Set splittransaction(const Data* r);
     static const Model_Splittransaction::Data_Set splittransaction(const Data& r);
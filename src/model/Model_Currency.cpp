@@ -26,6 +26,9 @@
 #include "option.h"
 #include "util.h"
 
+#include <algorithm>
+#include <climits>
+#include <locale>
 #include <fmt/core.h>
 #include <fmt/format.h>
 
@@ -163,33 +166,38 @@ Model_Currency::Data* Model_Currency::GetCurrencyRecord(const wxString& currency
     return record;
 }
 
-std::map<wxDateTime, int> Model_Currency::DateUsed(int CurrencyID)
+std::vector<mmDate> Model_Currency::DateUsed(int CurrencyID)
 {
-    wxDateTime dt;
-    std::map<wxDateTime, int> datesList;
-    const auto &accounts = Model_Account::instance().find(CURRENCYID(CurrencyID));
-    for (const auto &account : accounts)
+    mmTrace::Scope trace("Model_Currency::DateUsed");
+    std::vector<mmDate> dates;
+    try
     {
-        if (Model_Account::type(account) == Model_Account::TYPE::INVESTMENT)
-        {
-            for (const auto trans : Model_Stock::instance().find(Model_Stock::HELDAT(account.ACCOUNTID)))
-            {
-                dt.ParseDate(trans.PURCHASEDATE);
-                datesList[dt] = 1;
-            }
-        }
-        else
-        {
-            for (const auto& trans : Model_Checking::instance()
-                .find_or(Model_Checking::ACCOUNTID(account.ACCOUNTID)
-                , Model_Checking::TOACCOUNTID(account.ACCOUNTID)))
-            {
-                dt.ParseDate(trans.TRANSDATE);
-                datesList[dt] = 1;
-            }
-        }
+        // julianday() of a date-only value is its midnight, 2440587.5 is 1970-01-01
+        wxSQLite3Statement stmt = Model_Currency::instance().db_->PrepareStatement(
+            "SELECT DISTINCT CAST(julianday(substr(D, 1, 10)) - 2440587.5 AS INTEGER) AS DAY FROM ("
+            " SELECT TRANSDATE AS D FROM CHECKINGACCOUNT_V1 WHERE ACCOUNTID IN (SELECT ACCOUNTID FROM ACCOUNTLIST_V1"
+            "  WHERE CURRENCYID = :currency AND ACCOUNTTYPE <> :investment COLLATE NOCASE)"
+            " UNION ALL"
+            " SELECT TRANSDATE FROM CHECKINGACCOUNT_V1 WHERE TOACCOUNTID IN (SELECT ACCOUNTID FROM ACCOUNTLIST_V1"
+            "  WHERE CURRENCYID = :currency AND ACCOUNTTYPE <> :investment COLLATE NOCASE)"
+            " UNION ALL"
+            " SELECT PURCHASEDATE FROM STOCK_V1 WHERE HELDAT IN (SELECT ACCOUNTID FROM ACCOUNTLIST_V1"
+            "  WHERE CURRENCYID = :currency AND ACCOUNTTYPE = :investment COLLATE NOCASE)"
+            ") WHERE DAY IS NOT NULL ORDER BY DAY");
+        stmt.Bind(stmt.GetParamIndex(":currency"), CurrencyID);
+        stmt.Bind(stmt.GetParamIndex(":investment"), Model_Account::all_type()[Model_Account::INVESTMENT]);
+
+        wxSQLite3ResultSet q = stmt.ExecuteQuery();
+        while (q.NextRow())
+            dates.push_back(mmDate(q.GetInt(0)));
+        q.Finalize();
+        stmt.Finalize();
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogError("%s: Exception %s", Model_Currency::instance().name().utf8_str(), e.GetMessage().utf8_str());
     }
-    return datesList;
+    return dates;
 }
 /**
 * Remove the Data record from memory and the database.
@@ -206,12 +214,8 @@ bool Model_Currency::remove(int id)
 
 const wxString Model_Currency::toCurrency(double value, const Data* currency, int precision)
 {
-    wxString d2s = toString(value, currency, precision);
-    if (currency) {
-        d2s.Prepend(currency->PFX_SYMBOL);
-        d2s.Append(currency->SFX_SYMBOL);
-    }
-    return d2s;
+    // without a currency the base currency layout applies, but not its symbols
+    return currency ? formatter(currency).toCurrency(value, precision) : formatter(nullptr).toString(value, precision);
 }
 
 const wxString Model_Currency::toStringNoFormatting(double value, const Data* currency, int precision)
@@ -226,105 +230,170 @@ const wxString Model_Currency::toStringNoFormatting(double value, const Data* cu
 
 const wxString Model_Currency::toString(double value, const Data* currency, int precision)
 {
-    static wxString locale;
-    static wxString d; //default Locale Support Y/N
-    static wxString use_locale;
+    return formatter(currency).toString(value, precision);
+}
 
-    if (locale.empty()) {
-        locale = Model_Infotable::instance().GetStringInfo("LOCALE", " ");
-        if (locale.empty()) {
-            locale = " ";
-        }
-    }
+namespace
+{
+    struct NumberLayout
+    {
+        wxString decimal_point;
+        wxString group_separator;
+        std::string grouping;
+    };
 
-    if (use_locale.empty()) {
-        use_locale = locale == " " ? "N" : "Y";
-        if (use_locale == "Y")
-        {
-            try {
-                fmt::format(std::locale(locale.c_str()), "{:L}", 123);
-            }
-            catch (...) {
-                locale = " ";
-                use_locale = "N";
-            }
-        }
+    wxString layoutChar(char c)
+    {
+        //FIXME: #4191 separators outside ASCII are shown as a space
+        return (c > 0) ? wxString(c) : wxString(" ");
     }
 
-    if (d.empty())
+    /* Layout of the LOCALE setting, looked up once; nullptr when it is unset or unknown */
+    const NumberLayout* localeLayout()
     {
-        try {
-            fmt::format(std::locale("en_US.UTF-8"), "{:L}", 123);
-            d = "Y";
+        static bool resolved = false;
+        static NumberLayout layout;
+        static const NumberLayout* result = nullptr;
+        if (resolved) return result;
+        resolved = true;
+
+        const wxString locale = Model_Infotable::instance().GetStringInfo("LOCALE", " ");
+        if (locale.empty() || locale == " ") return result;
+        try
+        {
+            const std::locale l(locale.c_str());
+            const auto& punct = std::use_facet<std::numpunct<char> >(l);
+            layout.decimal_point = layoutChar(punct.decimal_point());
+            layout.group_separator = layoutChar(punct.thousands_sep());
+            layout.grouping = punct.grouping();
+            result = &layout;
         }
-        catch (...) {
-            d = "N";
+        catch (...)
+        {
         }
+        return result;
     }
+}
 
-    if (precision < 0) {
-        precision = log10(currency ? currency->SCALE : GetBaseCurrency()->SCALE);
+Model_Currency::Formatter::Formatter(const Data* currency)
+    : m_currency_id(currency->CURRENCYID)
+    , m_scale(currency->SCALE)
+    , m_precision(precision(currency))
+    , m_currency_decimal_point(currency->DECIMAL_POINT)
+    , m_currency_group_separator(currency->GROUP_SEPARATOR)
+    , m_prefix(currency->PFX_SYMBOL)
+    , m_suffix(currency->SFX_SYMBOL)
+{
+    const NumberLayout* layout = localeLayout();
+    if (layout)
+    {
+        m_decimal_point = layout->decimal_point;
+        m_group_separator = layout->group_separator;
+        m_grouping = layout->grouping;
+    }
+    else
+    {
+        m_decimal_point = currency->DECIMAL_POINT;
+        m_group_separator = currency->GROUP_SEPARATOR;
+        m_grouping = "\3";
     }
+}
 
-    auto l = (use_locale == "Y" ? std::locale(locale.c_str()) : std::locale("en_US.UTF-8"));
-    std::string s;
+bool Model_Currency::Formatter::matches(const Data* currency) const
+{
+    return m_currency_id == currency->CURRENCYID
+        && m_scale == currency->SCALE
+        && m_currency_decimal_point == currency->DECIMAL_POINT
+        && m_currency_group_separator == currency->GROUP_SEPARATOR
+        && m_prefix == currency->PFX_SYMBOL
+        && m_suffix == currency->SFX_SYMBOL;
+}
+
+size_t Model_Currency::Formatter::format(double value, int precision, wxChar* buf) const
+{
+    if (precision < 0) precision = m_precision;
+    if (precision > 9) precision = 4;
     value += LIMIT; //to ignore the negative sign on values of zero #564
 
-    switch (precision)
+    // fmt renders the plain digits independently of the C locale
+    char digits[BUFFER_SIZE];
+    const auto rendered = fmt::format_to_n(digits, sizeof(digits), "{:.{}f}", value, precision);
+    const char* p = digits;
+    const char* const end = digits + std::min(rendered.size, sizeof(digits));
+
+    size_t n = 0;
+    auto put = [&](const wxString& s)
+    {
+        for (size_t i = 0; i < s.length() && n < BUFFER_SIZE; i++) buf[n++] = s[i];
+    };
+
+    if (p < end && *p == '-')
     {
-    case (0):
-        s = (d == "Y") ? fmt::format(l, "{:.0Lf}", value) : fmt::format("{:.0f}", value);
-        break;
-    case (1):
-        s = (d == "Y") ? fmt::format(l, "{:.1Lf}", value) : fmt::format("{:.1f}", value);
-        break;
-    case (2):
-        s = (d == "Y") ? fmt::format(l, "{:.2Lf}", value) : fmt::format("{:.2f}", value);
-        break;
-    case (3):
-        s = (d == "Y") ? fmt::format(l, "{:.3Lf}", value) : fmt::format("{:.3f}", value);
-        break;
-    case (4):
-        s = (d == "Y") ? fmt::format(l, "{:.4Lf}", value) : fmt::format("{:.4f}", value);
-        break;
-    case (5):
-        s = (d == "Y") ? fmt::format(l, "{:.5Lf}", value) : fmt::format("{:.5f}", value);
-        break;
-    case (6):
-        s = (d == "Y") ? fmt::format(l, "{:.6Lf}", value) : fmt::format("{:.6f}", value);
-        break;
-    case (7):
-        s = (d == "Y") ? fmt::format(l, "{:.7Lf}", value) : fmt::format("{:.7f}", value);
-        break;
-    case (8):
-        s = (d == "Y") ? fmt::format(l, "{:.8Lf}", value) : fmt::format("{:.8f}", value);
-        break;
-    case (9):
-        s = (d == "Y") ? fmt::format(l, "{:.9Lf}", value) : fmt::format("{:.9f}", value);
-        break;
-    default:
-        s = (d == "Y") ? fmt::format(l, "{:.4Lf}", value) : fmt::format("{:.4f}", value);
+        buf[n++] = '-';
+        ++p;
     }
+    const char* int_end = std::find(p, end, '.');
+    const size_t int_len = int_end - p;
 
-#ifdef __WXMSW__
-    //FIXME: #4191
-    for (auto& i : s) {
-        if (i < 0) i = ' ';
+    // digit counts from the right that are preceded by a group separator
+    size_t marks[BUFFER_SIZE];
+    size_t mark_count = 0;
+    for (size_t i = 0, pos = 0; !m_grouping.empty() && !m_group_separator.empty(); i++)
+    {
+        const char group = m_grouping[std::min(i, m_grouping.size() - 1)];
+        if (group <= 0 || group == CHAR_MAX) break;
+        pos += group;
+        if (pos >= int_len) break;
+        marks[mark_count++] = pos;
     }
-#endif
 
-    if (use_locale == "N")
+    for (size_t i = 0; i < int_len && n < BUFFER_SIZE; i++)
     {
-        wxString out(s);
-        out.Replace(".", "\x05");
-        out.Replace(",", "\t");
-        out.Replace("\x05", currency ? currency->DECIMAL_POINT : GetBaseCurrency()->DECIMAL_POINT);
-        out.Replace("\t", currency ? currency->GROUP_SEPARATOR : GetBaseCurrency()->GROUP_SEPARATOR);
-        return out;
+        if (mark_count > 0 && int_len - i == marks[mark_count - 1])
+        {
+            put(m_group_separator);
+            --mark_count;
+        }
+        if (n < BUFFER_SIZE) buf[n++] = p[i];
     }
 
-    //wxLogDebug("toString : (%.12f) %s -> %s", value,  fmt::format("{:f}", value), s);
-    return wxString(s);
+    if (int_end < end)
+    {
+        put(m_decimal_point);
+        for (const char* d = int_end + 1; d < end && n < BUFFER_SIZE; d++) buf[n++] = *d;
+    }
+    return n;
+}
+
+const wxString Model_Currency::Formatter::toString(double value, int precision) const
+{
+    wxChar buf[BUFFER_SIZE];
+    return wxString(buf, format(value, precision, buf));
+}
+
+const wxString Model_Currency::Formatter::toCurrency(double value, int precision) const
+{
+    wxChar buf[BUFFER_SIZE];
+    const size_t len = format(value, precision, buf);
+    wxString out;
+    out.reserve(m_prefix.length() + len + m_suffix.length());
+    out << m_prefix;
+    out.append(buf, len);
+    out << m_suffix;
+    return out;
+}
+
+const Model_Currency::Formatter& Model_Currency::formatter(const Data* currency)
+{
+    static std::map<int, Formatter> formatters;
+    const Data* curr = currency ? currency : GetBaseCurrency();
+
+    auto it = formatters.find(curr->CURRENCYID);
+    if (it == formatters.end())
+        it = formatters.insert(std::make_pair(curr->CURRENCYID, Formatter(curr))).first;
+    else if (!it->second.matches(curr))
+        it->second = Formatter(curr);
+    return it->second;
 }
 
 const wxString Model_Currency::fromString2CLocale(const wxString &s, const Data* currency)
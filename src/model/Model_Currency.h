@@ -24,6 +24,7 @@
 #include "db/DB_Table_Currencyformats_V1.h"
 #include "Model_Infotable.h" // detect base currency setting BASECURRENCYID
 #include <map>
+#include <string>
 
 class Model_Currency : public Model<DB_Table_CURRENCYFORMATS_V1>
 {
@@ -77,7 +78,47 @@ public:
     */
     bool remove(int id);
 
-    static std::map<wxDateTime,int> DateUsed(int CurrencyID);
+    /**
+    Dates of the transactions and stock purchases in accounts of the currency,
+    read with one SELECT DISTINCT instead of loading every row.
+    * Return the sorted distinct dates
+    */
+    static std::vector<mmDate> DateUsed(int CurrencyID);
+
+    /**
+    Number layout of one currency, resolved once instead of per value:
+    separators and grouping come from the LOCALE setting when it is set,
+    otherwise from the currency record.
+    */
+    class Formatter
+    {
+    public:
+        /* Size in characters of the buffer passed to format() */
+        enum { BUFFER_SIZE = 512 };
+
+        explicit Formatter(const Data* currency);
+        /* True while the currency record still has the fields this layout was built from */
+        bool matches(const Data* currency) const;
+
+        /* Write the grouped value to buf without prefix, suffix or terminating zero, returns the length */
+        size_t format(double value, int precision, wxChar* buf) const;
+        const wxString toString(double value, int precision = -1) const;
+        const wxString toCurrency(double value, int precision = -1) const;
+
+    private:
+        int m_currency_id;
+        int m_scale;
+        int m_precision;
+        wxString m_currency_decimal_point;
+        wxString m_currency_group_separator;
+        wxString m_decimal_point;
+        wxString m_group_separator;
+        std::string m_grouping; // digits per group from the right, as std::numpunct::grouping()
+        wxString m_prefix;
+        wxString m_suffix;
+    };
+    /** Return the cached layout of the currency, the base currency when none is given */
+    static const Formatter& formatter(const Data* currency = GetBaseCurrency());
 
     /** Add prefix and suffix characters to string value */
     static const wxString toCurrency(double value, const Data* currency = GetBaseCurrency(), int precision = -1);
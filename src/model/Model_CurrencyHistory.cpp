@@ -83,6 +83,51 @@ int Model_CurrencyHistory::addUpdate(const int& currencyID, const wxDate& date,
     return save(currHist);
 }
 
+int Model_CurrencyHistory::addUpdate(const Data_Set& rows, bool replace)
+{
+    mmTrace::Scope trace("Model_CurrencyHistory::addUpdate");
+    int written = 0;
+    this->Savepoint("MMEX_Upsert");
+    try
+    {
+        // one prepared statement for all rows, the conflict target is the UNIQUE(CURRENCYID, CURRDATE) constraint
+        wxSQLite3Statement stmt = db_->PrepareStatement(replace
+            ? "INSERT INTO CURRENCYHISTORY_V1 (CURRENCYID, CURRDATE, CURRVALUE, CURRUPDTYPE) VALUES (?, ?, ?, ?)"
+              " ON CONFLICT (CURRENCYID, CURRDATE) DO UPDATE SET CURRVALUE = excluded.CURRVALUE, CURRUPDTYPE = excluded.CURRUPDTYPE"
+            : "INSERT OR IGNORE INTO CURRENCYHISTORY_V1 (CURRENCYID, CURRDATE, CURRVALUE, CURRUPDTYPE) VALUES (?, ?, ?, ?)");
+        for (const auto& r : rows)
+        {
+            stmt.Bind(1, r.CURRENCYID);
+            stmt.Bind(2, r.CURRDATE);
+            stmt.Bind(3, r.CURRVALUE);
+            stmt.Bind(4, r.CURRUPDTYPE);
+            written += stmt.ExecuteUpdate();
+            stmt.Reset();
+        }
+        stmt.Finalize();
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogError("%s: Exception %s", this->name().utf8_str(), e.GetMessage().utf8_str());
+        this->Rollback("MMEX_Upsert");
+        written = 0;
+    }
+    this->ReleaseSavepoint("MMEX_Upsert");
+
+    // rows not cached yet are read on demand, only the cached ones can hold old rates
+    if (replace && written > 0)
+    {
+        std::vector<int> cached;
+        for (const auto& r : rows)
+        {
+            const auto it = index_by_CURRENCYID_CURRDATE_.find(key_CURRENCYID_CURRDATE(r.CURRENCYID, r.CURRDATE));
+            if (it != index_by_CURRENCYID_CURRDATE_.end()) cached.push_back(it->second);
+        }
+        refresh_cache(cached);
+    }
+    return written;
+}
+
 /** Return the rate for a specific currency in a specific day*/
 double Model_CurrencyHistory::getDayRate(int currencyID, const wxString& DateISO)
 {
@@ -90,9 +135,9 @@ double Model_CurrencyHistory::getDayRate(int currencyID, const wxString& DateISO
         auto c = Model_Currency::instance().get(currencyID);
         return c ? c->BASECONVRATE : 1.0;
     }
-    wxDate Date;
-    if (Date.ParseDate(DateISO))
-        return Model_CurrencyHistory::getDayRate(currencyID, Date);
+    const mmDate Date = mmDate::FromISO(DateISO);
+    if (Date.IsValid())
+        return Model_CurrencyHistory::getDayRate(currencyID, Date.ToDateTime());
     else
     {
         wxASSERT(false);
@@ -122,10 +167,11 @@ double Model_CurrencyHistory::getDayRate(int currencyID, const wxDate& Date)
 
         if (!DataPrevious.empty() && !DataNext.empty())
         {
-            const wxTimeSpan spanPast = Date.Subtract(Model::to_date(DataPrevious.back().CURRDATE));
-            const wxTimeSpan spanFuture = Model::to_date(DataNext[0].CURRDATE).Subtract(Date);
+            const mmDate day(Date);
+            const int daysPast = day - DataPrevious.back().CURRDATE_date();
+            const int daysFuture = DataNext[0].CURRDATE_date() - day;
 
-            return spanPast <= spanFuture ? DataPrevious.back().CURRVALUE : DataNext[0].CURRVALUE;
+            return daysPast <= daysFuture ? DataPrevious.back().CURRVALUE : DataNext[0].CURRVALUE;
         }
         else if (!DataPrevious.empty())
         {
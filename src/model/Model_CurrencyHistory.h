@@ -55,6 +55,12 @@ public:
     
     /** Adds or updates an element in currency history */
     int addUpdate(const int& currencyID, const wxDate& date, double price, UPDTYPE type);
+    /**
+    Adds or updates many elements in one transaction, keyed by CURRENCYID and CURRDATE.
+    Existing rates are kept when replace is false.
+    * Return the number of rows written
+    */
+    int addUpdate(const Data_Set& rows, bool replace = true);
 
     /** Return the rate for a specific currency in a specific day*/
     static double getDayRate(int currencyID, const wxString& DateISO);
@@ -18,6 +18,7 @@
 
 #include "Model_CustomFieldData.h"
 #include "Model_CustomField.h"
+#include <set>
 #include <wx/string.h>
 
 Model_CustomFieldData::Model_CustomFieldData()
@@ -105,3 +106,59 @@ bool Model_CustomFieldData::DeleteAllData(const wxString& RefType, int RefID)
     }
     return true;
 }
+
+bool Model_CustomFieldData::DeleteAllData(const wxString& RefType, const std::vector<int>& RefIDs)
+{
+    wxString fields;
+    for (const auto& field : Model_CustomField::instance().find(Model_CustomField::DB_Table_CUSTOMFIELD_V1::REFTYPE(RefType)))
+        fields << (fields.empty() ? "" : ",") << field.FIELDID;
+    if (fields.empty()) return true;
+
+    Model_CustomFieldData::instance().remove_in(REFID::name(), RefIDs, "FIELDID IN (" + fields + ")");
+    return true;
+}
+
+void Model_CustomFieldData::SetAllData(int FieldID, const std::vector<int>& RefIDs, const wxString& Content)
+{
+    std::vector<int> existing;
+    std::set<int> has_data;
+    for (const auto& data : find_in(REFID::name(), RefIDs))
+    {
+        if (data.FIELDID != FieldID) continue;
+        existing.push_back(data.FIELDATADID);
+        has_data.insert(data.REFID);
+    }
+
+    this->Savepoint();
+    try
+    {
+        for (const auto& in : in_lists(existing))
+        {
+            wxSQLite3Statement stmt = db_->PrepareStatement("UPDATE CUSTOMFIELDDATA_V1 SET CONTENT = ? WHERE FIELDATADID IN (" + in + ")");
+            stmt.Bind(1, Content);
+            stmt.ExecuteUpdate();
+            stmt.Finalize();
+        }
+
+        wxSQLite3Statement stmt = db_->PrepareStatement("INSERT INTO CUSTOMFIELDDATA_V1 (FIELDID, REFID, CONTENT) VALUES (?, ?, ?)");
+        for (const auto& ref_id : RefIDs)
+        {
+            if (has_data.count(ref_id)) continue;
+            stmt.Bind(1, FieldID);
+            stmt.Bind(2, ref_id);
+            stmt.Bind(3, Content);
+            stmt.ExecuteUpdate();
+            stmt.Reset();
+        }
+        stmt.Finalize();
+    }
+    catch (const wxSQLite3Exception&)
+    {
+        this->Rollback();
+        this->ReleaseSavepoint();
+        throw;
+    }
+    this->ReleaseSavepoint();
+
+    refresh_cache(existing);
+}
@@ -52,6 +52,10 @@ public:
     Data* get(int FieldID, int RefID);
     wxArrayString allValue(const int FieldID);
     static bool DeleteAllData(const wxString& RefType, int RefID);
+    /** Delete the field data of many records with set-based statements */
+    static bool DeleteAllData(const wxString& RefType, const std::vector<int>& RefIDs);
+    /** Give the field the same content on many records, updating existing data and adding the missing */
+    void SetAllData(int FieldID, const std::vector<int>& RefIDs, const wxString& Content);
 };
 
 #endif
@@ -29,6 +29,14 @@ Model_Infotable::Model_Infotable()
 
 Model_Infotable::~Model_Infotable()
 {
+    try
+    {
+        Flush();
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogError("%s: Exception %s", this->name().utf8_str(), e.GetMessage().utf8_str());
+    }
 }
 
 /**
@@ -38,16 +46,21 @@ Model_Infotable::~Model_Infotable()
 Model_Infotable& Model_Infotable::instance(wxSQLite3Database* db)
 {
     Model_Infotable& ins = Singleton<Model_Infotable>::instance();
+    // pending values belong to the database being replaced
+    ins.Flush();
     ins.db_ = db;
+    ins.m_index.clear();
+    ins.m_dirty.clear();
     ins.destroy_cache();
     ins.ensure(db);
-    ins.preload();
+    ins.LoadIndex();
     if (!ins.KeyExists("MMEXVERSION"))
     {
         ins.Set("MMEXVERSION", mmex::version::string);
         ins.Set("DATAVERSION", mmex::DATAVERSION);
         ins.Set("CREATEDATE", wxDateTime::Now());
         ins.Set("DATEFORMAT", mmex::DEFDATEFORMAT);
+        ins.Flush();
     }
 
     return ins;
@@ -59,6 +72,46 @@ Model_Infotable& Model_Infotable::instance()
     return Singleton<Model_Infotable>::instance();
 }
 
+void Model_Infotable::LoadIndex()
+{
+    for (const auto& item : this->all())
+    {
+        Data* info = this->get(item.INFOID, this->db_);
+        m_index[info->INFONAME.Upper()] = info;
+    }
+}
+
+Model_Infotable::Data* Model_Infotable::FindInfo(const wxString& key)
+{
+    const auto it = m_index.find(key.Upper());
+    return it != m_index.end() ? it->second : nullptr;
+}
+
+void Model_Infotable::Flush()
+{
+    if (m_dirty.empty() || !this->db_ || !this->db_->IsOpen()) return;
+
+    this->Savepoint("MMEX_Infotable");
+    for (const auto& key : m_dirty)
+    {
+        Data* info = FindInfo(key);
+        if (info) info->save(this->db_);
+    }
+    this->ReleaseSavepoint("MMEX_Infotable");
+    m_dirty.clear();
+}
+
+void Model_Infotable::Remove(const wxString& key)
+{
+    Data* info = FindInfo(key);
+    if (!info) return;
+
+    m_index.erase(key.Upper());
+    m_dirty.erase(key.Upper());
+    if (info->id() > 0)
+        this->remove(info->INFOID);
+}
+
 // Setter
 void Model_Infotable::Set(const wxString& key, int value)
 {
@@ -82,24 +135,19 @@ void Model_Infotable::Set(const wxString& key, const wxSize& size)
 
 void Model_Infotable::Set(const wxString& key, const wxString& value)
 {
-    Data* info = this->get_one(INFONAME(key));
-    if (!info) // not cached
-    {
-        Data_Set items = this->find(INFONAME(key));
-        if (!items.empty()) info = this->get(items[0].INFOID);
-    }
-    if (info)
-    {
-        info->INFOVALUE= value;
-        info->save(this->db_);
-    }
-    else
+    Data* info = FindInfo(key);
+    if (!info)
     {
         info = this->create();
         info->INFONAME = key;
-        info->INFOVALUE = value;
-        info->save(this->db_);
+        m_index[key.Upper()] = info;
+    }
+    else if (info->INFOVALUE == value)
+    {
+        return;
     }
+    info->INFOVALUE = value;
+    m_dirty.insert(key.Upper());
 }
 
 void Model_Infotable::Set(const wxString& key, const wxColour& value)
@@ -109,25 +157,15 @@ void Model_Infotable::Set(const wxString& key, const wxColour& value)
 
 void Model_Infotable::Prepend(const wxString& key, const wxString& value, int limit)
 {
-    Data* setting = this->get_one(INFONAME(key));
-    if (!setting) // not cached
-    {
-        Data_Set items = this->find(INFONAME(key));
-        if (!items.empty()) setting = this->get(items[0].INFOID);
-    }
-
-    if (!setting)
-    {
-        setting = this->create();
-        setting->INFONAME = key;
-    }
+    const Data* setting = FindInfo(key);
     int i = 1;
     wxArrayString a;
     if (!value.empty() && limit != 0)
         a.Add(value);
 
+    const wxString data = setting ? setting->INFOVALUE : wxString("[]");
     Document j_doc;
-    if (j_doc.Parse(setting->INFOVALUE.utf8_str()).HasParseError()) {
+    if (j_doc.Parse(data.utf8_str()).HasParseError()) {
         j_doc.Parse("[]");
     }
 
@@ -155,8 +193,7 @@ void Model_Infotable::Prepend(const wxString& key, const wxString& value, int li
     }
     json_writer.EndArray();
 
-    setting->INFOVALUE = wxString::FromUTF8(json_buffer.GetString());
-    setting->save(this->db_);
+    this->Set(key, wxString::FromUTF8(json_buffer.GetString()));
 }
 
 void Model_Infotable::Erase(const wxString& key, int row)
@@ -229,17 +266,8 @@ int Model_Infotable::GetIntInfo(const wxString& key, int default_value)
 
 wxString Model_Infotable::GetStringInfo(const wxString& key, const wxString& default_value)
 {
-    Data* info = this->get_one(INFONAME(key));
-    if (info)
-        return info->INFOVALUE;
-    else // not cached
-    {
-        Data_Set items = this->find(INFONAME(key));
-        if (!items.empty())
-            return items[0].INFOVALUE;
-    }
-
-    return default_value;
+    const Data* info = FindInfo(key);
+    return info ? info->INFOVALUE : default_value;
 }
 const wxSize Model_Infotable::GetSizeSetting(const wxString& key)
 {
@@ -282,22 +310,11 @@ const wxColour Model_Infotable::GetColourSetting(const wxString& key, const wxCo
 
 const wxArrayString Model_Infotable::GetArrayStringSetting(const wxString& key, bool sort)
 {
-    wxString data;
-    Data* setting = this->get_one(INFONAME(key));
-    if (!setting) // not cached
-    {
-        Data_Set items = this->find(INFONAME(key));
-        if (items.empty()) {
-            return wxArrayString();
-        }
-        else {
-            data = items[0].INFOVALUE;
-        }
-    }
-    else
-    {
-        data = setting->INFOVALUE;
+    const Data* setting = FindInfo(key);
+    if (!setting) {
+        return wxArrayString();
     }
+    const wxString& data = setting->INFOVALUE;
 
     wxArrayString a;
     Document j_doc;
@@ -326,7 +343,7 @@ const wxArrayString Model_Infotable::GetArrayStringSetting(const wxString& key,
 /* Returns true if key setting found */
 bool Model_Infotable::KeyExists(const wxString& key)
 {
-    return !this->find(INFONAME(key)).empty();
+    return FindInfo(key) != nullptr;
 }
 
 bool Model_Infotable::checkDBVersion()
@@ -338,12 +355,25 @@ bool Model_Infotable::checkDBVersion()
 
 loop_t Model_Infotable::to_loop_t()
 {
+    std::vector<const Data*> items;
+    for (const auto& item : instance().m_index)
+        items.push_back(item.second);
+    std::sort(items.begin(), items.end(), [](const Data* x, const Data* y) {
+        return x->INFOID < y->INFOID;
+    });
+
     loop_t loop;
-    for (const auto &r: instance().all())
-        loop += r.to_row_t();
+    for (const auto r : items)
+        loop += r->to_row_t();
     return loop;
 }
 
+void Model_Infotable::to_template(html_template& t)
+{
+    for (const auto& item : instance().m_index)
+        t(item.second->INFONAME.ToStdWstring()) = item.second->INFOVALUE;
+}
+
 //-------------------------------------------------------------------
 bool Model_Infotable::OpenCustomDialog(const wxString& RefType)
 {
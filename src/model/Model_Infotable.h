@@ -23,6 +23,7 @@
 #include "Model.h"
 #include "db/DB_Table_Infotable_V1.h"
 #include "defs.h"
+#include <unordered_set>
 
 class Model_Infotable : public Model<DB_Table_INFOTABLE_V1>
 {
@@ -56,6 +57,7 @@ public:
     void Prepend(const wxString& key, const wxString& value, int limit);
     void Erase(const wxString& key, int row);
     void Update(const wxString& key, int row, const wxString& value);
+    void Remove(const wxString& key);
 
 public:
     // Getter
@@ -80,6 +82,20 @@ public:
     void SetCustomDialogSize(const wxString& RefType, const wxSize& Size);
     //Use to search through a set of JSON data for a particular label
     int FindLabelInJSON(const wxString& entry, const wxString& labelID);
+
+public:
+    /* Write all modified values back to the database in one transaction */
+    void Flush();
+    /* Assign every INFONAME/INFOVALUE pair to the template */
+    static void to_template(html_template& t);
+
+private:
+    /* Values are held in memory keyed by upper-cased INFONAME and
+       written back by Flush() on idle, before reports and on close */
+    void LoadIndex();
+    Data* FindInfo(const wxString& key);
+    std::unordered_map<wxString, Data*> m_index;
+    std::unordered_set<wxString> m_dirty;
 };
 
 #endif // 
@@ -115,15 +115,21 @@ const std::map<wxString, int> Model_Payee::used_payee()
         cache[p.PAYEEID] = p.PAYEENAME;
 
     std::map<wxString, int> payees;
-    for (const auto &t : Model_Checking::instance().all())
+    try
     {
-        if (cache.count(t.PAYEEID) > 0)
-            payees[cache[t.PAYEEID]] = t.PAYEEID;
+        wxSQLite3ResultSet q = this->db_->ExecuteQuery(
+            "SELECT DISTINCT PAYEEID FROM CHECKINGACCOUNT_V1 UNION SELECT PAYEEID FROM BILLSDEPOSITS_V1");
+        while (q.NextRow())
+        {
+            const int id = q.GetInt(0);
+            if (cache.count(id) > 0)
+                payees[cache[id]] = id;
+        }
+        q.Finalize();
     }
-    for (const auto& b : Model_Billsdeposits::instance().all())
+    catch (const wxSQLite3Exception& e)
     {
-        if (cache.count(b.PAYEEID) > 0)
-            payees[cache[b.PAYEEID]] = b.PAYEEID;
+        wxLogError("%s: Exception %s", this->name().utf8_str(), e.GetMessage().utf8_str());
     }
     return payees;
 }
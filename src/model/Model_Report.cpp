@@ -25,14 +25,19 @@
 #include "mmreportspanel.h"
 #include "reports/htmlbuilder.h"
 #include "model/Model_Setting.h"
+#include "model/Model_Infotable.h"
 #include "LuaGlue/LuaGlue.h"
 #include "sqlite3mc_amalgamation.h"
 #include <wx/fs_mem.h>
+#include <wx/stopwatch.h>
 
 #if defined (__WXMSW__)
     #include <wx/msw/registry.h>
 #endif
 
+// Approximate bookkeeping cost of a single cell in row_t
+static const size_t REPORT_CELL_OVERHEAD = 64;
+
 class Record : public std::map<std::wstring, std::wstring>
 {
 public:
@@ -168,6 +173,105 @@ bool Model_Report::get_objects_from_sql(const wxString& query, PrettyWriter<Stri
     return true;
 }
 
+bool Model_Report::profile_sql(const wxString& query, SqlProfile& profile, wxString& error)
+{
+    profile = SqlProfile();
+    wxString sql = query;
+    std::map <wxString, wxString> rep_params;
+    if (!PrepareSQL(sql, rep_params))
+    {
+        error = _("SQL is empty");
+        return false;
+    }
+
+    wxStopWatch sw;
+    try
+    {
+        wxSQLite3Statement stmt = this->db_->PrepareStatement(sql);
+        profile.prepare_ms = sw.TimeInMicro().ToDouble() / 1000.0;
+        if (!stmt.IsReadOnly())
+        {
+            error = _("the sql is not readonly");
+            return false;
+        }
+
+        const wxLongLong step_start = sw.TimeInMicro();
+        wxSQLite3ResultSet q = stmt.ExecuteQuery();
+        while (q.NextRow())
+            profile.rows_returned++;
+        profile.step_ms = (sw.TimeInMicro() - step_start).ToDouble() / 1000.0;
+
+        profile.fullscan_steps = stmt.Status(WXSQLITE_STMTSTATUS_FULLSCAN_STEP);
+        profile.sort_ops = stmt.Status(WXSQLITE_STMTSTATUS_SORT);
+        profile.auto_indexes = stmt.Status(WXSQLITE_STMTSTATUS_AUTOINDEX);
+        profile.vm_steps = stmt.Status(WXSQLITE_STMTSTATUS_VM_STEP);
+        q.Finalize();
+        profile.total_ms = sw.TimeInMicro().ToDouble() / 1000.0;
+
+        // The plan is a tree linked by id/parent, the rows come in display order
+        std::map<int, int> depth_by_id;
+        wxSQLite3ResultSet plan = this->db_->ExecuteQuery("EXPLAIN QUERY PLAN " + sql);
+        while (plan.NextRow())
+        {
+            int id = plan.GetInt(0);
+            int parent = plan.GetInt(1);
+            const wxString detail = plan.GetAsString(3);
+            int depth = depth_by_id.count(parent) ? depth_by_id[parent] + 1 : 0;
+            depth_by_id[id] = depth;
+            profile.plan.push_back(std::make_pair(depth, detail));
+
+            if (detail.StartsWith("SCAN ") && !detail.Contains(" USING ")
+                && !detail.StartsWith("SCAN SUBQUERY") && !detail.StartsWith("SCAN CONSTANT ROW"))
+            {
+                wxString table = detail.Mid(5);
+                if (table.StartsWith("TABLE ")) table = table.Mid(6);
+                table = table.BeforeFirst(' ');
+                profile.suggestions.Add(wxString::Format(_("Full table scan of %s: filter or join on an indexed column, e.g. CREATE INDEX ... ON %s(<column>)"), table, table));
+            }
+            else if (detail.Contains("AUTOMATIC"))
+            {
+                profile.suggestions.Add(wxString::Format(_("SQLite builds a temporary index (%s): a permanent index on these columns would avoid it"), detail));
+            }
+            else if (detail.StartsWith("USE TEMP B-TREE FOR ORDER BY") || detail.StartsWith("USE TEMP B-TREE FOR GROUP BY"))
+            {
+                profile.suggestions.Add(wxString::Format(_("%s: an index matching the sort columns would avoid the extra sort"), detail));
+            }
+        }
+        plan.Finalize();
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        error = e.GetMessage();
+        return false;
+    }
+
+    return true;
+}
+
+void Model_Report::save_profile(int report_id, const SqlProfile& profile)
+{
+    StringBuffer json_buffer;
+    Writer<StringBuffer> json_writer(json_buffer);
+    json_writer.StartObject();
+    json_writer.Key("DATE");
+    json_writer.String(wxDateTime::Now().FormatISOCombined(' ').utf8_str());
+    json_writer.Key("TOTAL_MS");
+    json_writer.Double(profile.total_ms);
+    json_writer.Key("ROWS");
+    json_writer.Uint64(profile.rows_returned);
+    json_writer.Key("FULLSCAN_STEPS");
+    json_writer.Int(profile.fullscan_steps);
+    json_writer.EndObject();
+
+    Model_Infotable::instance().Prepend(wxString::Format("REPORT_PROFILE_%d", report_id)
+        , wxString::FromUTF8(json_buffer.GetString()), 10);
+}
+
+const wxArrayString Model_Report::profile_history(int report_id)
+{
+    return Model_Infotable::instance().GetArrayStringSetting(wxString::Format("REPORT_PROFILE_%d", report_id));
+}
+
 wxArrayString Model_Report::allGroupNames()
 {
     wxArrayString groups;
@@ -225,6 +329,33 @@ bool Model_Report::PrepareSQL(wxString& sql, std::map <wxString, wxString>& rep_
     return true;
 }
 
+wxSQLite3ResultSet Model_Report::ExecuteLimited(const wxString& sql, int limit)
+{
+    wxString body = sql;
+    body.Trim().RemoveLast(); // PrepareSQL() ends it with ';'
+    try
+    {
+        wxSQLite3Statement stmt = this->db_->PrepareStatement(wxString::Format("SELECT * FROM (\n%s\n) LIMIT %d;", body, limit));
+        wxSQLite3ResultSet q = stmt.ExecuteQuery();
+        // SELECT * renames duplicate column names to "name:1", the template would not find them
+        for (int i = 0; i < q.GetColumnCount(); ++i)
+        {
+            const wxString name = q.GetColumnName(i);
+            if (name.AfterLast(':').IsNumber() && name.Contains(":"))
+            {
+                q.Finalize();
+                return wxSQLite3ResultSet();
+            }
+        }
+        return q;
+    }
+    catch (const wxSQLite3Exception&)
+    {
+        // not usable as a subquery, e.g. several statements
+        return wxSQLite3ResultSet();
+    }
+}
+
 int Model_Report::get_html(const Data* r, wxString& out)
 {
     wxString sql = r->SQLCONTENT;
@@ -236,7 +367,11 @@ int Model_Report::get_html(const Data* r, wxString& out)
 
     wxSQLite3ResultSet q;
     int columnCount = 0;
+    const int row_limit = Option::instance().getReportRowLimit();
+    const int memory_limit = Option::instance().getReportMemoryLimit();
     std::map <wxString, wxString> rep_params;
+    // Reports may read INFOTABLE_V1 directly
+    Model_Infotable::instance().Flush();
     try
     {
         PrepareSQL(sql, rep_params);
@@ -249,7 +384,12 @@ int Model_Report::get_html(const Data* r, wxString& out)
         }
         else
         {
-            q = stmt.ExecuteQuery();
+            // With a row limit SQLite stops after the first row past it,
+            // instead of producing every row only for the loop to drop them
+            if (row_limit > 0)
+                q = ExecuteLimited(sql, row_limit + 1);
+            if (!q.IsOk())
+                q = stmt.ExecuteQuery();
             columnCount = q.GetColumnCount();
         }
     }
@@ -260,6 +400,9 @@ int Model_Report::get_html(const Data* r, wxString& out)
     }
 
     std::map <std::wstring, int> colHeaders;
+    // Column names are resolved once per run instead of once per row and cell
+    std::vector<std::wstring> colNames;
+    colNames.reserve(columnCount);
 
     mm_html_template report(templatecontent);
     r->to_template(report);
@@ -273,6 +416,7 @@ int Model_Report::get_html(const Data* r, wxString& out)
         int col_type = q.GetColumnType(i);
         const std::wstring col_name = q.GetColumnName(i).ToStdWstring();
         colHeaders[col_name] = col_type;
+        colNames.push_back(col_name);
         row_t row;
         row(L"COLUMN") = col_name;
         columns += row;
@@ -299,13 +443,35 @@ int Model_Report::get_html(const Data* r, wxString& out)
         //state.doString(R"(sys_locale=os.setlocale("", "numeric"); print(os.setlocale("C", "numeric"));)");
     }
 
+    size_t rows = 0;
+    size_t used_memory = 0;
+    bool row_limit_exceeded = false;
+    bool memory_limit_exceeded = false;
+
+    // One record is reused for every row; Lua may add keys so it is
+    // only rebuilt when handle_record changed its shape.
+    Record rec;
+    for (const auto& name : colNames)
+        rec[name];
+
     while (q.NextRow())
     {
-        Record rec;
+        if (row_limit > 0 && rows >= static_cast<size_t>(row_limit))
+        {
+            row_limit_exceeded = true;
+            break;
+        }
+
+        if (rec.size() != colNames.size())
+        {
+            rec.clear();
+            for (const auto& name : colNames)
+                rec[name];
+        }
+
         for (int i = 0; i < columnCount; ++i)
         {
-            const wxString column_name = q.GetColumnName(i);
-            rec[column_name.ToStdWstring()] = q.GetAsString(i);
+            rec[colNames[i]] = q.GetAsString(i).ToStdWstring();
         }
 
         if (lua_status && !skip_lua)
@@ -334,12 +500,30 @@ int Model_Report::get_html(const Data* r, wxString& out)
         for (const auto& item : rec)
         {
             row(item.first) = item.second;
+            used_memory += (item.first.size() + item.second.size()) * sizeof(wchar_t) + REPORT_CELL_OVERHEAD;
         }
         contents += row;
+        rows++;
 
+        if (memory_limit > 0 && used_memory > static_cast<size_t>(memory_limit) * 1024 * 1024)
+        {
+            memory_limit_exceeded = true;
+            break;
+        }
     }
     q.Finalize();
 
+    if (row_limit_exceeded || memory_limit_exceeded)
+    {
+        const wxString reason = row_limit_exceeded
+            ? wxString::Format(_("it exceeded the limit of %d rows"), row_limit)
+            : wxString::Format(_("it exceeded the limit of %d MB"), memory_limit);
+        out = wxString::Format(_("The report \"%s\" was stopped after %zu rows because %s.\n"
+            "Please restrict the SQL query (e.g. with a date range or LIMIT clause)."),
+            r->REPORTNAME, rows, reason);
+        return 4;
+    }
+
     Record result;
     if (lua_status && !skip_lua)
     {
@@ -52,6 +52,26 @@ public:
     int get_html(const Data* r, wxString& out);
     //wxString get_html(const Data& r);
 
+public:
+    /* Execution statistics of a report SQL collected by profile_sql */
+    struct SqlProfile
+    {
+        double prepare_ms = 0.0;
+        double step_ms = 0.0;
+        double total_ms = 0.0;
+        size_t rows_returned = 0;
+        int fullscan_steps = 0;
+        int sort_ops = 0;
+        int auto_indexes = 0;
+        int vm_steps = 0;
+        // EXPLAIN QUERY PLAN rows as (depth, detail)
+        std::vector<std::pair<int, wxString>> plan;
+        wxArrayString suggestions;
+    };
+    bool profile_sql(const wxString& query, SqlProfile& profile, wxString& error);
+    void save_profile(int report_id, const SqlProfile& profile);
+    const wxArrayString profile_history(int report_id);
+
 public:
     Data* get(const wxString& name);
     static bool PrepareSQL(wxString& sql, std::map <wxString, wxString>& rep_params);
@@ -67,6 +87,8 @@ private:
         wxString name;
     };
     static const std::vector<Values> SqlPlaceHolders();
+    /** Run the prepared report sql wrapped in LIMIT, or return an invalid result set if it cannot be */
+    wxSQLite3ResultSet ExecuteLimited(const wxString& sql, int limit);
 };
 
 #endif // 
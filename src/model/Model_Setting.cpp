@@ -30,6 +30,14 @@ Model_Setting::Model_Setting()
 
 Model_Setting::~Model_Setting()
 {
+    try
+    {
+        Flush();
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogError("%s: Exception %s", this->name().utf8_str(), e.GetMessage().utf8_str());
+    }
 }
 
 /**
@@ -39,10 +47,14 @@ Model_Setting::~Model_Setting()
 Model_Setting& Model_Setting::instance(wxSQLite3Database* db)
 {
     Model_Setting& ins = Singleton<Model_Setting>::instance();
+    // pending values belong to the database being replaced
+    ins.Flush();
     ins.db_ = db;
+    ins.m_index.clear();
+    ins.m_dirty.clear();
     ins.destroy_cache();
     ins.ensure(db);
-    ins.preload();
+    ins.LoadIndex();
 
     return ins;
 }
@@ -53,6 +65,35 @@ Model_Setting& Model_Setting::instance()
     return Singleton<Model_Setting>::instance();
 }
 
+void Model_Setting::LoadIndex()
+{
+    for (const auto& item : this->all())
+    {
+        Data* setting = this->get(item.SETTINGID, this->db_);
+        m_index[setting->SETTINGNAME.Upper()] = setting;
+    }
+}
+
+Model_Setting::Data* Model_Setting::FindSetting(const wxString& key)
+{
+    const auto it = m_index.find(key.Upper());
+    return it != m_index.end() ? it->second : nullptr;
+}
+
+void Model_Setting::Flush()
+{
+    if (m_dirty.empty() || !this->db_ || !this->db_->IsOpen()) return;
+
+    this->Savepoint();
+    for (const auto& key : m_dirty)
+    {
+        Data* setting = FindSetting(key);
+        if (setting) setting->save(this->db_);
+    }
+    this->ReleaseSavepoint();
+    m_dirty.clear();
+}
+
 // Setter
 void Model_Setting::Set(const wxString& key, int value)
 {
@@ -71,47 +112,31 @@ void Model_Setting::Set(const wxString& key, const wxColour& value)
 
 void Model_Setting::Set(const wxString& key, const wxString& value)
 {
-    Data* setting = this->get_one(SETTINGNAME(key));
-    if (!setting) // not cached
-    {
-        Data_Set items = this->find(SETTINGNAME(key));
-        if (!items.empty()) setting = this->get(items[0].SETTINGID, this->db_);
-    }
-    if (setting)
-    {
-        setting->SETTINGVALUE = value;
-        setting->save(this->db_);
-    }
-    else
+    Data* setting = FindSetting(key);
+    if (!setting)
     {
         setting = this->create();
         setting->SETTINGNAME = key;
-        setting->SETTINGVALUE = value;
-        setting->save(this->db_);
+        m_index[key.Upper()] = setting;
     }
+    else if (setting->SETTINGVALUE == value)
+    {
+        return;
+    }
+    setting->SETTINGVALUE = value;
+    m_dirty.insert(key.Upper());
 }
 
 void Model_Setting::Prepend(const wxString& key, const wxString& value, int limit)
 {
-    Data* setting = this->get_one(SETTINGNAME(key));
-    if (!setting) // not cached
-    {
-        Data_Set items = this->find(SETTINGNAME(key));
-        if (!items.empty()) setting = this->get(items[0].SETTINGID, this->db_);
-    }
-
-    if (!setting)
-    {
-        setting = this->create();
-        setting->SETTINGNAME = key;
-    }
-
+    Data* setting = FindSetting(key);
     int i = 1;
     wxArrayString a;
     a.Add(value);
 
+    const wxString data = setting ? setting->SETTINGVALUE : wxString("[]");
     Document j_doc;
-    if (j_doc.Parse(setting->SETTINGVALUE.utf8_str()).HasParseError()) {
+    if (j_doc.Parse(data.utf8_str()).HasParseError()) {
         j_doc.Parse("[]");
     }
 
@@ -139,8 +164,7 @@ void Model_Setting::Prepend(const wxString& key, const wxString& value, int limi
     }
     json_writer.EndArray();
 
-    setting->SETTINGVALUE = wxString::FromUTF8(json_buffer.GetString());
-    setting->save(this->db_);
+    this->Set(key, wxString::FromUTF8(json_buffer.GetString()));
 }
 
 // Getter
@@ -163,37 +187,17 @@ int Model_Setting::GetIntSetting(const wxString& key, int default_value)
 
 const wxString Model_Setting::GetStringSetting(const wxString& key, const wxString& default_value)
 {
-    Data* setting = this->get_one(SETTINGNAME(key));
-    if (!setting) // not cached
-    {
-        Data_Set items = this->find(SETTINGNAME(key));
-        if (!items.empty()) return items[0].SETTINGVALUE;
-    }
-    else
-    {
-        return setting->SETTINGVALUE;
-    }
-    return default_value;
+    const Data* setting = FindSetting(key);
+    return setting ? setting->SETTINGVALUE : default_value;
 }
 
 const wxArrayString Model_Setting::GetArrayStringSetting(const wxString& key)
 {
-    wxString data;
-    Data* setting = this->get_one(SETTINGNAME(key));
-    if (!setting) // not cached
-    {
-        Data_Set items = this->find(SETTINGNAME(key));
-        if (items.empty()) {
-            return wxArrayString();
-        }
-        else {
-            data = items[0].SETTINGVALUE;
-        }
-    }
-    else
-    {
-        data = setting->SETTINGVALUE;
+    const Data* setting = FindSetting(key);
+    if (!setting) {
+        return wxArrayString();
     }
+    const wxString& data = setting->SETTINGVALUE;
 
     wxArrayString a;
     Document j_doc;
@@ -240,14 +244,14 @@ wxString Model_Setting::getLastDbPath()
 /* Returns true if key setting found */
 bool Model_Setting::ContainsSetting(const wxString& key)
 {
-    return !this->find(SETTINGNAME(key)).empty();
+    return FindSetting(key) != nullptr;
 }
 
 row_t Model_Setting::to_row_t()
 {
     row_t row;
-    for (const auto &r: instance().all())
-        row(r.SETTINGNAME.ToStdWstring()) = r.SETTINGVALUE;
+    for (const auto& item : instance().m_index)
+        row(item.second->SETTINGNAME.ToStdWstring()) = item.second->SETTINGVALUE;
     return row;
 }
 
@@ -294,6 +298,7 @@ void Model_Setting::ShrinkUsageTable()
         return;
     }
 
+    Flush();
     const wxString save_point = "SETTINGS_TRIM_USAGE";
     wxDate date(wxDate::Now());
     date.Subtract(wxDateSpan::Months(2));
@@ -24,6 +24,7 @@
 #include "Model.h"
 #include "db/DB_Table_Setting_V1.h"
 #include "defs.h"
+#include <unordered_set>
 
 class Model_Setting : public Model<DB_Table_SETTING_V1>
 {
@@ -92,6 +93,18 @@ public:
     void SetViewTransactions(const wxString& value);
     
     void ShrinkUsageTable();
+
+public:
+    /* Write all modified settings back to the database in one transaction */
+    void Flush();
+
+private:
+    /* Settings are held in memory keyed by upper-cased SETTINGNAME and
+       written back by Flush() on idle or close */
+    void LoadIndex();
+    Data* FindSetting(const wxString& key);
+    std::unordered_map<wxString, Data*> m_index;
+    std::unordered_set<wxString> m_dirty;
 };
 
 #endif 
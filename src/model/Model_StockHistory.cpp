@@ -86,3 +86,48 @@ int Model_StockHistory::addUpdate(const wxString& symbol, const wxDate& date, do
 
     return save(stockHist);
 }
+
+int Model_StockHistory::addUpdate(const Data_Set& rows, bool replace)
+{
+    mmTrace::Scope trace("Model_StockHistory::addUpdate");
+    int written = 0;
+    this->Savepoint("MMEX_Upsert");
+    try
+    {
+        // one prepared statement for all rows, the conflict target is the UNIQUE(SYMBOL, DATE) constraint
+        wxSQLite3Statement stmt = db_->PrepareStatement(replace
+            ? "INSERT INTO STOCKHISTORY_V1 (SYMBOL, DATE, VALUE, UPDTYPE) VALUES (?, ?, ?, ?)"
+              " ON CONFLICT (SYMBOL, DATE) DO UPDATE SET VALUE = excluded.VALUE, UPDTYPE = excluded.UPDTYPE"
+            : "INSERT OR IGNORE INTO STOCKHISTORY_V1 (SYMBOL, DATE, VALUE, UPDTYPE) VALUES (?, ?, ?, ?)");
+        for (const auto& r : rows)
+        {
+            stmt.Bind(1, r.SYMBOL);
+            stmt.Bind(2, r.DATE);
+            stmt.Bind(3, r.VALUE);
+            stmt.Bind(4, r.UPDTYPE);
+            written += stmt.ExecuteUpdate();
+            stmt.Reset();
+        }
+        stmt.Finalize();
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogError("%s: Exception %s", this->name().utf8_str(), e.GetMessage().utf8_str());
+        this->Rollback("MMEX_Upsert");
+        written = 0;
+    }
+    this->ReleaseSavepoint("MMEX_Upsert");
+
+    // rows not cached yet are read on demand, only the cached ones can hold old prices
+    if (replace && written > 0)
+    {
+        std::vector<int> cached;
+        for (const auto& r : rows)
+        {
+            const auto it = index_by_SYMBOL_DATE_.find(key_SYMBOL_DATE(r.SYMBOL, r.DATE));
+            if (it != index_by_SYMBOL_DATE_.end()) cached.push_back(it->second);
+        }
+        refresh_cache(cached);
+    }
+    return written;
+}
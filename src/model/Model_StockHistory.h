@@ -56,6 +56,12 @@ public:
     Adds or updates an element in stock history
     */
     int addUpdate(const wxString& symbol, const wxDate& date, double price, UPDTYPE type);
+    /**
+    Adds or updates many elements in one transaction, keyed by SYMBOL and DATE.
+    Existing prices are kept when replace is false. The stocks' current prices are not changed.
+    * Return the number of rows written
+    */
+    int addUpdate(const Data_Set& rows, bool replace = true);
 };
 
 #endif // 
@@ -0,0 +1,215 @@
+/*******************************************************
+Copyright (C) 2026 MoneyManagerEx contributors
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+********************************************************/
+
+#include "navtreemodel.h"
+#include "util.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+mmNavTreeModel::Node::~Node()
+{
+    delete data;
+}
+
+mmNavTreeModel::mmNavTreeModel()
+{
+}
+
+mmNavTreeModel::~mmNavTreeModel()
+{
+}
+
+mmNavTreeModel::Node* mmNavTreeModel::node(const wxTreeItemId& item)
+{
+    return static_cast<Node*>(item.GetID());
+}
+
+wxTreeItemId mmNavTreeModel::AddRoot(const wxString& text, int image, int /*selImage*/)
+{
+    m_root.reset(new Node);
+    m_root->text = text;
+    m_root->image = image;
+    return wxTreeItemId(m_root.get());
+}
+
+wxTreeItemId mmNavTreeModel::AppendItem(const wxTreeItemId& parent, const wxString& text, int image, int /*selImage*/)
+{
+    Node* p = node(parent);
+    p->children.emplace_back(new Node);
+    Node* n = p->children.back().get();
+    n->text = text;
+    n->image = image;
+    n->parent = p;
+    return wxTreeItemId(n);
+}
+
+void mmNavTreeModel::SetItemData(const wxTreeItemId& item, mmTreeItemData* data)
+{
+    Node* n = node(item);
+    delete n->data;
+    n->data = data;
+}
+
+void mmNavTreeModel::SetItemBold(const wxTreeItemId& item, bool bold)
+{
+    node(item)->bold = bold;
+}
+
+bool mmNavTreeModel::ItemHasChildren(const wxTreeItemId& item) const
+{
+    return !node(item)->children.empty();
+}
+
+void mmNavTreeModel::Delete(const wxTreeItemId& item)
+{
+    Node* n = node(item);
+    if (!n->parent)
+    {
+        m_root.reset();
+        return;
+    }
+    auto& siblings = n->parent->children;
+    siblings.erase(std::find_if(siblings.begin(), siblings.end()
+        , [n](const std::unique_ptr<Node>& c) { return c.get() == n; }));
+}
+
+// Identity of a node across refreshes: what it opens, not what it is called,
+// so a renamed account is updated in place. Nodes without data fall back to the label.
+wxString mmNavTreeModel::key(const wxString& text, const mmTreeItemData* data)
+{
+    if (!data) return "#" + text;
+    return wxString::Format("%i:%i:%s", data->getType(), data->getData(), data->getString());
+}
+
+wxString mmNavTreeModel::key(wxTreeCtrl* tree, const wxTreeItemId& item)
+{
+    return key(tree->GetItemText(item), dynamic_cast<mmTreeItemData*>(tree->GetItemData(item)));
+}
+
+std::vector<wxTreeItemId> mmNavTreeModel::Apply(wxTreeCtrl* tree)
+{
+    m_inserted.clear();
+    if (!m_root)
+    {
+        tree->DeleteAllItems();
+        return m_inserted;
+    }
+
+    wxTreeItemId root = tree->GetRootItem();
+    if (!root.IsOk())
+    {
+        root = tree->AddRoot(m_root->text, m_root->image, m_root->image);
+        build(tree, root, *m_root);
+        m_inserted.push_back(root);
+    }
+    else
+    {
+        sync(tree, root, *m_root);
+    }
+    return m_inserted;
+}
+
+void mmNavTreeModel::update(wxTreeCtrl* tree, const wxTreeItemId& item, Node& n)
+{
+    if (tree->GetItemText(item) != n.text)
+        tree->SetItemText(item, n.text);
+    if (tree->GetItemImage(item) != n.image)
+    {
+        tree->SetItemImage(item, n.image);
+        tree->SetItemImage(item, n.image, wxTreeItemIcon_Selected);
+    }
+    if (tree->IsBold(item) != n.bold)
+        tree->SetItemBold(item, n.bold);
+
+    // the data is always replaced: reports keep pointers into model caches
+    // that may have been reloaded since the item was created
+    wxTreeItemData* old = tree->GetItemData(item);
+    tree->SetItemData(item, n.data);
+    n.data = nullptr;
+    delete old;
+}
+
+void mmNavTreeModel::build(wxTreeCtrl* tree, const wxTreeItemId& item, Node& n)
+{
+    if (n.bold) tree->SetItemBold(item, true);
+    tree->SetItemData(item, n.data);
+    n.data = nullptr;
+
+    for (auto& child : n.children)
+    {
+        wxTreeItemId c = tree->AppendItem(item, child->text, child->image, child->image);
+        build(tree, c, *child);
+    }
+}
+
+void mmNavTreeModel::sync(wxTreeCtrl* tree, const wxTreeItemId& item, Node& n)
+{
+    update(tree, item, n);
+
+    std::vector<wxString> keys;
+    std::unordered_map<wxString, int> pending;
+    for (const auto& child : n.children)
+    {
+        keys.push_back(key(child->text, child->data));
+        pending[keys.back()]++;
+    }
+
+    wxTreeItemIdValue cookie;
+    wxTreeItemId cur = tree->GetFirstChild(item, cookie);
+    wxTreeItemId prev;
+    for (size_t i = 0; i < n.children.size(); i++)
+    {
+        Node& child = *n.children[i];
+        const wxString& k = keys[i];
+
+        // drop items that are gone from the model altogether
+        wxString cur_key;
+        while (cur.IsOk() && (cur_key = key(tree, cur)) != k && pending[cur_key] == 0)
+        {
+            wxTreeItemId next = tree->GetNextSibling(cur);
+            tree->Delete(cur);
+            cur = next;
+        }
+        pending[k]--;
+
+        if (cur.IsOk() && cur_key == k)
+        {
+            sync(tree, cur, child);
+            prev = cur;
+            cur = tree->GetNextSibling(cur);
+        }
+        else
+        {
+            // new here, or moved by a rename; a moved item is dropped when reached
+            wxTreeItemId created = prev.IsOk()
+                ? tree->InsertItem(item, prev, child.text, child.image, child.image)
+                : tree->PrependItem(item, child.text, child.image, child.image);
+            build(tree, created, child);
+            prev = created;
+            m_inserted.push_back(created);
+        }
+    }
+
+    while (cur.IsOk())
+    {
+        wxTreeItemId next = tree->GetNextSibling(cur);
+        tree->Delete(cur);
+        cur = next;
+    }
+}
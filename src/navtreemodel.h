@@ -0,0 +1,75 @@
+/*******************************************************
+Copyright (C) 2026 MoneyManagerEx contributors
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+********************************************************/
+
+#ifndef MM_EX_NAVTREEMODEL_H_
+#define MM_EX_NAVTREEMODEL_H_
+
+#include <memory>
+#include <vector>
+#include <wx/treectrl.h>
+
+class mmTreeItemData;
+
+/*
+    Off-screen copy of the navigation tree. The builders fill it through the
+    same calls they would make on a wxTreeCtrl, then Apply() edits the real
+    control in place: matching nodes are renamed or re-imaged, only nodes
+    that appeared or disappeared are inserted or deleted, so expansion and
+    selection of everything else survive a refresh.
+*/
+class mmNavTreeModel
+{
+public:
+    mmNavTreeModel();
+    ~mmNavTreeModel();
+
+    wxTreeItemId AddRoot(const wxString& text, int image, int selImage);
+    wxTreeItemId AppendItem(const wxTreeItemId& parent, const wxString& text, int image, int selImage);
+    void SetItemData(const wxTreeItemId& item, mmTreeItemData* data);
+    void SetItemBold(const wxTreeItemId& item, bool bold = true);
+    bool ItemHasChildren(const wxTreeItemId& item) const;
+    void Delete(const wxTreeItemId& item);
+
+    /* Returns the nodes that had to be created in the control, each with its whole subtree */
+    std::vector<wxTreeItemId> Apply(wxTreeCtrl* tree);
+
+private:
+    struct Node
+    {
+        wxString text;
+        int image = -1;
+        bool bold = false;
+        mmTreeItemData* data = nullptr;
+        Node* parent = nullptr;
+        std::vector<std::unique_ptr<Node>> children;
+        ~Node();
+    };
+
+    static Node* node(const wxTreeItemId& item);
+    static wxString key(const wxString& text, const mmTreeItemData* data);
+    static wxString key(wxTreeCtrl* tree, const wxTreeItemId& item);
+
+    void update(wxTreeCtrl* tree, const wxTreeItemId& item, Node& n);
+    void sync(wxTreeCtrl* tree, const wxTreeItemId& item, Node& n);
+    void build(wxTreeCtrl* tree, const wxTreeItemId& item, Node& n);
+
+    std::unique_ptr<Node> m_root;
+    std::vector<wxTreeItemId> m_inserted;
+};
+
+#endif // MM_EX_NAVTREEMODEL_H_
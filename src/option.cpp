@@ -100,6 +100,9 @@ void Option::LoadOptions(bool include_infotable)
     m_navigation_ico_size = Model_Setting::instance().GetIntSetting("NAVIGATIONICONSIZE", 24);
     m_bulk_enter = Model_Setting::instance().GetBoolSetting("BULK_TRX", false);
     m_font_size = Model_Setting::instance().GetIntSetting("UI_FONT_SIZE", 0);
+    m_report_row_limit = Model_Setting::instance().GetIntSetting("GRM_ROW_LIMIT", 0);
+    m_report_memory_limit = Model_Setting::instance().GetIntSetting("GRM_MEMORY_LIMIT", 0);
+    m_db_performance_profile = Model_Setting::instance().GetBoolSetting("DB_PERFORMANCE_PROFILE", false);
 }
 
 void Option::setDateFormat(const wxString& date_format)
@@ -432,6 +435,12 @@ void Option::setHomePageIncExpRange(int value)
     m_homepage_incexp_range = value;
 }
 
+void Option::setDatabasePerformanceProfile(bool value)
+{
+    Model_Setting::instance().Set("DB_PERFORMANCE_PROFILE", value);
+    m_db_performance_profile = value;
+}
+
 int Option::AccountImageId(int account_id, bool def, bool ignoreClosure)
 {
     wxString acctStatus = VIEW_ACCOUNTS_OPEN_STR;
@@ -164,6 +164,14 @@ public:
     void setHomePageIncExpRange(int value);
     int getHomePageIncExpRange() const;
 
+    // Bounds of a general report run (GRM_ROW_LIMIT rows, GRM_MEMORY_LIMIT MB), 0 = unlimited
+    int getReportRowLimit() const;
+    int getReportMemoryLimit() const;
+
+    // SQLite tuning (WAL, mmap, page cache) applied when the database is opened, off by default
+    void setDatabasePerformanceProfile(bool value);
+    bool getDatabasePerformanceProfile() const;
+
 private:
     wxString m_dateFormat;
     wxLanguage m_language = wxLANGUAGE_UNKNOWN;
@@ -206,6 +214,9 @@ private:
     int m_reporting_firstday = 1;
 
     int m_homepage_incexp_range;
+    int m_report_row_limit = 0;
+    int m_report_memory_limit = 0;
+    bool m_db_performance_profile = false;
 };
 
 inline int Option::getIconSize() { return m_ico_size; }
@@ -268,3 +279,18 @@ inline int Option::getHomePageIncExpRange() const
 {
     return m_homepage_incexp_range;
 }
+
+inline int Option::getReportRowLimit() const
+{
+    return m_report_row_limit;
+}
+
+inline int Option::getReportMemoryLimit() const
+{
+    return m_report_memory_limit;
+}
+
+inline bool Option::getDatabasePerformanceProfile() const
+{
+    return m_db_performance_profile;
+}
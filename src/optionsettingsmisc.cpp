@@ -186,6 +186,21 @@ void OptionSettingsMisc::Create()
         "creates or updates the backup database: dbFile_update_YYYY-MM-DD.ext."));
     databaseStaticBoxSizer->Add(databaseUpdateCheckBox, g_flagsV);
 
+    wxCheckBox* databaseCompressCheckBox = new wxCheckBox(misc_panel, ID_DIALOG_OPTIONS_CHK_BACKUP_COMPRESS
+        , _("Compress backups"), wxDefaultPosition, wxDefaultSize, wxCHK_2STATE);
+    databaseCompressCheckBox->SetValue(GetIniDatabaseCheckboxValue("BACKUPDB_COMPRESS", false));
+    databaseCompressCheckBox->SetToolTip(_("Store backups gzip compressed: dbFile_update_YYYY-MM-DD.ext.bak.gz.\n"
+        "Decompress the file before opening it."));
+    databaseStaticBoxSizer->Add(databaseCompressCheckBox, g_flagsV);
+
+    wxCheckBox* databaseProfileCheckBox = new wxCheckBox(misc_panel, ID_DIALOG_OPTIONS_CHK_DB_PROFILE
+        , _("Optimize database access"), wxDefaultPosition, wxDefaultSize, wxCHK_2STATE);
+    databaseProfileCheckBox->SetValue(Option::instance().getDatabasePerformanceProfile());
+    databaseProfileCheckBox->SetToolTip(_("Use write-ahead logging, a larger cache and memory-mapped reads.\n"
+        "Leave disabled when the database is stored on a network share or a synchronized folder.\n"
+        "Enabling it takes effect when the database is reopened, disabling it returns the open database to a rollback journal."));
+    databaseStaticBoxSizer->Add(databaseProfileCheckBox, g_flagsV);
+
     int max = Model_Setting::instance().GetIntSetting("MAX_BACKUP_FILES", 4);
     m_max_files = new wxSpinCtrl(misc_panel, wxID_ANY
         , wxEmptyString, wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, 1, 999, max);
@@ -250,9 +265,7 @@ void OptionSettingsMisc::SaveStocksUrl()
     }
     else
     {
-        Model_Infotable::Data_Set items = Model_Infotable::instance().find(Model_Infotable::INFONAME("STOCKURL"));
-        if (!items.empty())
-            Model_Infotable::instance().remove(items[0].INFOID);
+        Model_Infotable::instance().Remove("STOCKURL");
     }
 }
 
@@ -285,6 +298,12 @@ bool OptionSettingsMisc::SaveSettings()
     wxCheckBox* itemCheckBoxUpdate = static_cast<wxCheckBox*>(FindWindow(ID_DIALOG_OPTIONS_CHK_BACKUP_UPDATE));
     Model_Setting::instance().Set("BACKUPDB_UPDATE", itemCheckBoxUpdate->GetValue());
 
+    wxCheckBox* itemCheckBoxCompress = static_cast<wxCheckBox*>(FindWindow(ID_DIALOG_OPTIONS_CHK_BACKUP_COMPRESS));
+    Model_Setting::instance().Set("BACKUPDB_COMPRESS", itemCheckBoxCompress->GetValue());
+
+    wxCheckBox* itemCheckBoxProfile = static_cast<wxCheckBox*>(FindWindow(ID_DIALOG_OPTIONS_CHK_DB_PROFILE));
+    Option::instance().setDatabasePerformanceProfile(itemCheckBoxProfile->GetValue());
+
     Model_Setting::instance().Set("MAX_BACKUP_FILES", m_max_files->GetValue());
     Model_Setting::instance().Set("DELETED_TRANS_RETAIN_DAYS", m_deleted_trans_retain_days->GetValue());
 
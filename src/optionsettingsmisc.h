@@ -56,6 +56,8 @@ private:
         ID_DIALOG_OPTIONS_TEXTCTRL_DELIMITER4 = wxID_HIGHEST + 10,
         ID_DIALOG_OPTIONS_CHK_BACKUP,
         ID_DIALOG_OPTIONS_CHK_BACKUP_UPDATE,
+        ID_DIALOG_OPTIONS_CHK_BACKUP_COMPRESS,
+        ID_DIALOG_OPTIONS_CHK_DB_PROFILE,
         ID_DIALOG_OPTIONS_TEXTCTRL_STOCKURL,
         ID_DIALOG_OPTIONS_BULK_ENTER,
         ID_DIALOG_OPTIONS_DEFAULT_TRANSACTION_PAYEE,
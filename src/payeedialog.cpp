@@ -394,7 +394,7 @@ void mmPayeeDialog::fillControls()
         break;    
     case PAYEE_NAME:
     default:
-        std::stable_sort(payees.begin(), payees.end(), SorterByPAYEENAME());
+        sort_by_key(payees, SorterByPAYEENAME());
         break; 
     }
 
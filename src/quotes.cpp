@@ -0,0 +1,212 @@
+/*******************************************************
+ Copyright (C) 2026 MoneyManagerEx contributors
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "quotes.h"
+#include "util.h"
+#include "mmTrace.h"
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/utils.h>
+#include <algorithm>
+#include <string>
+
+namespace
+{
+    const long MAX_HOST_CONNECTIONS = 6;
+    const std::chrono::seconds CACHE_TTL(60);
+
+    size_t WriteToString(char* data, size_t size, size_t nmemb, void* userp)
+    {
+        static_cast<std::string*>(userp)->append(data, size * nmemb);
+        return size * nmemb;
+    }
+}
+
+mmCurlQuoteProvider::mmCurlQuoteProvider()
+    : m_multi(curl_multi_init())
+{
+    if (m_multi)
+        curl_multi_setopt(m_multi, CURLMOPT_MAX_HOST_CONNECTIONS, MAX_HOST_CONNECTIONS);
+}
+
+mmCurlQuoteProvider::~mmCurlQuoteProvider()
+{
+    if (m_multi) curl_multi_cleanup(m_multi);
+}
+
+std::vector<mmHttpResult> mmCurlQuoteProvider::get(const std::vector<wxString>& urls)
+{
+    std::vector<mmHttpResult> results(urls.size(), mmHttpResult{ CURLE_FAILED_INIT, wxEmptyString });
+    if (!m_multi) return results;
+
+    std::vector<std::string> bodies(urls.size());
+    std::vector<CURL*> handles(urls.size(), nullptr);
+    for (size_t i = 0; i < urls.size(); i++)
+    {
+        CURL* curl = curl_easy_init();
+        if (!curl) continue;
+
+        // proxy, timeout and user agent as for http_get_data()
+        curl_set_common_options(curl);
+        curl_easy_setopt(curl, CURLOPT_URL, static_cast<const char*>(urls[i].mb_str()));
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteToString);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &bodies[i]);
+        curl_multi_add_handle(m_multi, curl);
+        handles[i] = curl;
+    }
+
+    int running = 0;
+    do
+    {
+        if (curl_multi_perform(m_multi, &running) != CURLM_OK) break;
+        if (running) curl_multi_wait(m_multi, nullptr, 0, 100, nullptr);
+    } while (running);
+
+    int queued = 0;
+    while (CURLMsg* msg = curl_multi_info_read(m_multi, &queued))
+    {
+        if (msg->msg != CURLMSG_DONE) continue;
+        const auto it = std::find(handles.begin(), handles.end(), msg->easy_handle);
+        if (it != handles.end())
+            results[it - handles.begin()].code = msg->data.result;
+    }
+
+    for (size_t i = 0; i < urls.size(); i++)
+    {
+        if (!handles[i]) continue;
+        curl_multi_remove_handle(m_multi, handles[i]);
+        curl_easy_cleanup(handles[i]);
+
+        if (results[i].code == CURLE_OK)
+            results[i].output = wxString::FromUTF8(bodies[i].c_str());
+        else
+        {
+            results[i].output = curl_easy_strerror(results[i].code);
+            wxLogDebug("mmCurlQuoteProvider: URL = %s error = %s", urls[i], results[i].output);
+        }
+    }
+    return results;
+}
+
+mmFileQuoteProvider::mmFileQuoteProvider(const wxString& dir)
+    : m_dir(dir)
+{
+}
+
+wxString mmFileQuoteProvider::FileName(const wxString& url)
+{
+    wxString name;
+    for (const auto& c : url)
+        name += wxIsalnum(c) ? wxUniChar(c) : wxUniChar('_');
+    return name;
+}
+
+std::vector<mmHttpResult> mmFileQuoteProvider::get(const std::vector<wxString>& urls)
+{
+    std::vector<mmHttpResult> results;
+    for (const auto& url : urls)
+    {
+        mmHttpResult result = { CURLE_COULDNT_CONNECT, wxEmptyString };
+        wxFFile file(wxFileName(m_dir, FileName(url)).GetFullPath(), "rb");
+        if (file.IsOpened() && file.ReadAll(&result.output, wxConvUTF8))
+            result.code = CURLE_OK;
+        else
+            result.output = wxString::Format("No response file for %s", url);
+        results.push_back(result);
+    }
+    return results;
+}
+
+mmQuoteService::mmQuoteService()
+{
+    wxString dir;
+    if (wxGetEnv("MMEX_QUOTES_DIR", &dir) && !dir.empty())
+        m_provider.reset(new mmFileQuoteProvider(dir));
+    else
+        m_provider.reset(new mmCurlQuoteProvider());
+}
+
+mmQuoteService& mmQuoteService::instance()
+{
+    static mmQuoteService service;
+    return service;
+}
+
+void mmQuoteService::SetProvider(std::unique_ptr<mmQuoteProvider> provider)
+{
+    m_provider = std::move(provider);
+    m_cache.clear();
+}
+
+void mmQuoteService::ClearCache()
+{
+    m_cache.clear();
+}
+
+void mmQuoteService::Shutdown()
+{
+    m_provider.reset();
+    m_cache.clear();
+}
+
+CURLcode mmQuoteService::get(const wxString& url, wxString& output)
+{
+    const mmHttpResult result = get(std::vector<wxString>(1, url)).front();
+    output = result.output;
+    return result.code;
+}
+
+std::vector<mmHttpResult> mmQuoteService::get(const std::vector<wxString>& urls)
+{
+    mmTrace::Scope trace("mmQuoteService::get");
+    const clock::time_point now = clock::now();
+
+    std::vector<wxString> missing;
+    for (const auto& url : urls)
+    {
+        const auto it = m_cache.find(url);
+        if ((it == m_cache.end() || now - it->second.time > CACHE_TTL)
+            && std::find(missing.begin(), missing.end(), url) == missing.end())
+            missing.push_back(url);
+    }
+
+    std::map<wxString, mmHttpResult> fetched;
+    if (!missing.empty())
+    {
+        const std::vector<mmHttpResult> results = m_provider
+            ? m_provider->get(missing)
+            : std::vector<mmHttpResult>(missing.size(), mmHttpResult{ CURLE_FAILED_INIT, "Quote service is shut down" });
+        for (size_t i = 0; i < missing.size(); i++)
+        {
+            fetched.insert(std::make_pair(missing[i], results[i]));
+            if (results[i].code == CURLE_OK)
+                m_cache[missing[i]] = Entry{ now, results[i].output };
+        }
+    }
+
+    std::vector<mmHttpResult> results;
+    for (const auto& url : urls)
+    {
+        const auto it = fetched.find(url);
+        if (it != fetched.end())
+            results.push_back(it->second);
+        else
+            results.push_back(mmHttpResult{ CURLE_OK, m_cache[url].output });
+    }
+    return results;
+}
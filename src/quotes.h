@@ -0,0 +1,111 @@
+/*******************************************************
+ Copyright (C) 2026 MoneyManagerEx contributors
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#ifndef MM_EX_QUOTES_H_
+#define MM_EX_QUOTES_H_
+
+#include <wx/string.h>
+#include <curl/curl.h>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <vector>
+
+struct mmHttpResult
+{
+    CURLcode code;
+    wxString output; // response body, or the error text
+};
+
+/* Where the quote and rate responses come from */
+class mmQuoteProvider
+{
+public:
+    virtual ~mmQuoteProvider() {}
+    /* Fetch every url, the results are in the same order */
+    virtual std::vector<mmHttpResult> get(const std::vector<wxString>& urls) = 0;
+};
+
+/*
+Runs the requests concurrently through the libcurl multi interface.
+The multi handle is kept between calls, so connections to the quote hosts are reused.
+*/
+class mmCurlQuoteProvider : public mmQuoteProvider
+{
+public:
+    mmCurlQuoteProvider();
+    ~mmCurlQuoteProvider();
+    std::vector<mmHttpResult> get(const std::vector<wxString>& urls);
+
+private:
+    mmCurlQuoteProvider(const mmCurlQuoteProvider&) = delete;
+    mmCurlQuoteProvider& operator=(const mmCurlQuoteProvider&) = delete;
+    CURLM* m_multi;
+};
+
+/*
+Answers from files in a directory instead of the network, for offline runs.
+Each url maps to the file named by FileName(url).
+*/
+class mmFileQuoteProvider : public mmQuoteProvider
+{
+public:
+    explicit mmFileQuoteProvider(const wxString& dir);
+    std::vector<mmHttpResult> get(const std::vector<wxString>& urls);
+    /* The url with every character other than letters and digits replaced by '_' */
+    static wxString FileName(const wxString& url);
+
+private:
+    wxString m_dir;
+};
+
+/*
+Entry point for the online quote and rate functions in util.cpp.
+Successful responses are cached for a short time, so refreshing prices
+from several dialogs in a row does not download them again; a refresh
+the user asks for explicitly calls ClearCache() first.
+The provider is the network by default, or the directory named by the
+MMEX_QUOTES_DIR environment variable. Use from the GUI thread only.
+*/
+class mmQuoteService
+{
+public:
+    static mmQuoteService& instance();
+
+    CURLcode get(const wxString& url, wxString& output);
+    std::vector<mmHttpResult> get(const std::vector<wxString>& urls);
+
+    void SetProvider(std::unique_ptr<mmQuoteProvider> provider);
+    void ClearCache();
+    /* Release the provider before curl_global_cleanup(), later requests fail */
+    void Shutdown();
+
+private:
+    mmQuoteService();
+
+    typedef std::chrono::steady_clock clock;
+    struct Entry
+    {
+        clock::time_point time;
+        wxString output;
+    };
+    std::unique_ptr<mmQuoteProvider> m_provider;
+    std::map<wxString, Entry> m_cache;
+};
+
+#endif // MM_EX_QUOTES_H_
@@ -243,8 +243,8 @@ wxString mmReportCashFlow::getHTMLText_DayOrMonth(bool monthly)
         wxString date = trx.TRANSDATE;
         if (monthly)
         {
-            dt.ParseDate(trx.TRANSDATE);
-            date = dt.SetDay(1).FormatISODate();
+            const mmDate day = trx.TRANSDATE_date();
+            date = mmDate(1, day.GetMonth(), day.GetYear()).FormatISODate();
         }
         if (dateMap.count(date) == 0)
             dateMap[date] = trx.TRANSAMOUNT;
@@ -428,10 +428,7 @@ wxString mmReportCashFlowTransactions::getHTMLText()
     runningBalance = m_balance;
     for (const auto& trx : m_forecastVector)
     {
-        wxDateTime dt;
-        int rowDate;
-        dt.ParseDate(trx.TRANSDATE);
-        rowDate = dt.GetMonth();
+        const int rowDate = trx.TRANSDATE_date().GetMonth();
         if (rowDate != lastRowDate)
         {
             lastRowDate = rowDate;
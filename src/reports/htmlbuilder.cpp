@@ -350,25 +350,28 @@ void mmHTMLBuilder::addTableHeaderCell(const wxString& value, const wxString& cs
 
 void mmHTMLBuilder::addCurrencyCell(double amount, const Model_Currency::Data* currency, int precision, bool isVoid)
 {
-    if (precision == -1)
-        precision = Model_Currency::precision(currency);
-    wxString s = Model_Currency::toCurrency(amount, currency, precision);
-    if (isVoid)
-        s = wxString::Format("<s>%s</s>", s);
     const wxString f = wxString::Format(" class='money' sorttable_customkey = '%f' nowrap", amount);
     html_ += wxString::Format(tags::TABLE_CELL, f);
-    html_ += s;
+    if (isVoid) html_ += "<s>";
+    if (!currency) currency = Model_Currency::GetBaseCurrency();
+    // formatted straight into the page, no intermediate string per cell
+    wxChar buf[Model_Currency::Formatter::BUFFER_SIZE];
+    html_ += currency->PFX_SYMBOL;
+    html_.append(buf, Model_Currency::formatter(currency).format(amount, precision, buf));
+    html_ += currency->SFX_SYMBOL;
+    if (isVoid) html_ += "</s>";
     this->endTableCell();
 }
 
 void mmHTMLBuilder::addMoneyCell(double amount, int precision)
 {
-    if (precision == -1)
-        precision = Model_Currency::precision(Model_Currency::GetBaseCurrency());
-    const wxString s = Model_Currency::toString(amount, Model_Currency::GetBaseCurrency(), precision);
     wxString f = wxString::Format(" class='money' sorttable_customkey = '%f' nowrap", amount);
     html_ += wxString::Format(tags::TABLE_CELL, f);
-    html_ += (amount == -DBL_MAX) ? "" : s;     // If -DBL_MAX then just display empty string
+    if (amount != -DBL_MAX)     // If -DBL_MAX then just display empty string
+    {
+        wxChar buf[Model_Currency::Formatter::BUFFER_SIZE];
+        html_.append(buf, Model_Currency::formatter().format(amount, precision, buf));
+    }
     this->endTableCell();
 }
 
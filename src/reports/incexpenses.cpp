@@ -162,9 +162,8 @@ wxString mmReportIncomeExpensesMonthly::getHTMLText()
         double convRate = 1;
         // We got this far, get the currency conversion rate for this account
         if (account) convRate = Model_CurrencyHistory::getDayRate(Model_Account::currency(account)->CURRENCYID, transaction.TRANSDATE);
-        int year = Model_Checking::TRANSDATE(transaction).GetYear();
-
-        int idx = year * 100 + Model_Checking::TRANSDATE(transaction).GetMonth();
+        const mmDate date = transaction.TRANSDATE_date();
+        int idx = date.GetYear() * 100 + date.GetMonth();
 
         if (Model_Checking::type(transaction) == Model_Checking::DEPOSIT) {
             incomeExpensesStats[idx].first += transaction.TRANSAMOUNT * convRate;
@@ -232,7 +232,7 @@ void mmPrintableBase::setAccounts(int selection, const wxString& name)
             auto a = Model_Account::instance().find(Model_Account::ACCOUNTTYPE(Model_Account::all_type()[Model_Account::INVESTMENT], NOT_EQUAL));
             std::stable_sort(a.begin(), a.end(), SorterByACCOUNTNAME());
             for (const auto& item : a) {
-                if (m_only_active && item.STATUS != Model_Account::all_status()[Model_Account::OPEN])
+                if (m_only_active && item.STATUS != Model_Account::STATUS_CHOICES[Model_Account::OPEN].second)
                     continue;
                 accounts.Add(item.ACCOUNTNAME);
             }
@@ -360,8 +360,7 @@ mm_html_template::mm_html_template(const wxString& arg_template): html_template(
 void mm_html_template::load_context()
 {
     (*this)(L"TODAY") = wxDate::Now().FormatISODate();
-    for (const auto &r: Model_Infotable::instance().all())
-        (*this)(r.INFONAME.ToStdWstring()) = r.INFOVALUE;
+    Model_Infotable::to_template(*this);
     (*this)(L"INFOTABLE") = Model_Infotable::to_loop_t();
 
     const Model_Currency::Data* currency = Model_Currency::GetBaseCurrency();
@@ -191,9 +191,12 @@ wxString mmReportSummaryByDate::getHTMLText()
     };
     std::reverse(arDates.begin(), arDates.end());
 
+    const Model_Asset::Data_Set assets = Model_Asset::instance().all();
+    const auto assetValues = Model_Asset::instance().valueAtDates(assets, arDates);
 
-    for (const auto & end_date : arDates)
+    for (size_t d = 0; d < arDates.size(); d++)
     {
+        const wxDate& end_date = arDates[d];
         double total = 0.0;
         double assetBalance = 0;
         // prepare columns for report: date, cash, checking, CC, loan, term, asset, shares, partial total, investment, grand total
@@ -212,8 +215,8 @@ wxString mmReportSummaryByDate::getHTMLText()
             balancePerDay[Model_Account::type(account)] += getDailyBalanceAt(&account, end_date) * getDayRate(account.CURRENCYID, end_date);
         }
 
-        for (const auto& asset : Model_Asset::instance().all()) {
-            assetBalance += Model_Asset::instance().valueAtDate(&asset, end_date) * getDayRate(asset.CURRENCYID, end_date);
+        for (size_t a = 0; a < assets.size(); a++) {
+            assetBalance += assetValues[a][d] * getDayRate(assets[a].CURRENCYID, end_date);
         }
 
         totBalanceEntry.values.push_back(balancePerDay[Model_Account::CASH]);
@@ -459,13 +459,13 @@ void mmReportTransactions::Run(wxSharedPtr<mmFilterTransactionsDialog>& dlg)
     switch (dlg.get()->mmGetGroupBy())
     {
     case mmFilterTransactionsDialog::GROUPBY_ACCOUNT:
-        std::stable_sort(trans_.begin(), trans_.end(), SorterByACCOUNTNAME());
+        sort_by_key(trans_, SorterByACCOUNTNAME());
         break;
     case mmFilterTransactionsDialog::GROUPBY_PAYEE:
-        std::stable_sort(trans_.begin(), trans_.end(), SorterByPAYEENAME());
+        sort_by_key(trans_, SorterByPAYEENAME());
         break;
     case mmFilterTransactionsDialog::GROUPBY_CATEGORY:
-        std::stable_sort(trans_.begin(), trans_.end(), SorterByCATEGNAME());
+        sort_by_key(trans_, SorterByCATEGNAME());
         break;
     case mmFilterTransactionsDialog::GROUPBY_TYPE:
         std::stable_sort(trans_.begin(), trans_.end(), SorterByTRANSCODE());
@@ -25,6 +25,7 @@
 #include "mmSimpleDialogs.h"
 #include "mmTextCtrl.h"
 #include "paths.h"
+#include "quotes.h"
 #include "util.h"
 #include "validators.h"
 
@@ -577,8 +578,7 @@ void mmStockDialog::OnHistoryImportButton(wxCommandEvent& /*event*/)
         long countImported = 0;
         double price;
         wxString dateStr, priceStr;
-        Model_StockHistory::Data *data;
-        Model_StockHistory::Cache stockData;
+        Model_StockHistory::Data_Set stockData;
 
         wxString line;
         std::vector<wxString> rows;
@@ -624,11 +624,11 @@ void mmStockDialog::OnHistoryImportButton(wxCommandEvent& /*event*/)
             if (!Model_Currency::fromString(priceStr, price, currency) || price <= 0.0)
                 continue;
 
-            data = Model_StockHistory::instance().create();
-            data->SYMBOL = m_stock->SYMBOL;
-            data->DATE = dateStr;
-            data->VALUE = price;
-            data->UPDTYPE = 2;
+            Model_StockHistory::Data data;
+            data.SYMBOL = m_stock->SYMBOL;
+            data.DATE = dateStr;
+            data.VALUE = price;
+            data.UPDTYPE = Model_StockHistory::MANUAL;
             stockData.push_back(data);
 
             if (rows.size()<10)
@@ -656,19 +656,13 @@ void mmStockDialog::OnHistoryImportButton(wxCommandEvent& /*event*/)
             canceledbyuser = true;
         }
  
-        // Since all database transactions are only in memory,
+        // The quotes are only in memory until confirmed
         if (!canceledbyuser)
         {
-            // we need to save them to the database. 
-            for (auto &d : stockData)
-                Model_StockHistory::instance().save(d);
+            Model_StockHistory::instance().addUpdate(stockData);
             // show the data
             ShowStockHistory();
         }
-        else 
-        {
-            //TODO: and discard the database changes.
-        }
     }
 }
 
@@ -731,7 +725,7 @@ void mmStockDialog::OnHistoryDownloadButton(wxCommandEvent& /*event*/)
         , m_stock->SYMBOL, range, interval);
 
     wxString json_data;
-    auto err_code = http_get_data(URL, json_data);
+    auto err_code = mmQuoteService::instance().get(URL, json_data);
     wxString sOutput = json_data;
 
     if (err_code != CURLE_OK)
@@ -821,32 +815,24 @@ void mmStockDialog::OnHistoryDownloadButton(wxCommandEvent& /*event*/)
         }
 
         const wxString today = wxDate::Today().FormatISODate();
-        Model_StockHistory::instance().Savepoint();
+        Model_StockHistory::Data_Set prices;
         for (const auto& entry : history)
         {
             float dPrice = entry.second;
             const wxString date_str = wxDateTime(static_cast<time_t>(entry.first)).FormatISODate();
-            if (date_str == today) {
+            if (date_str == today || dPrice <= 0) {
                 continue;
             }
 
-            if (Model_StockHistory::instance()
-                .find(
-                    Model_StockHistory::SYMBOL(m_stock->SYMBOL)
-                    , Model_StockHistory::DB_Table_STOCKHISTORY_V1::DATE(date_str)
-                ).empty()
-                && dPrice > 0
-                )
-            {
-                Model_StockHistory::Data* ndata = Model_StockHistory::instance().create();
-                ndata->SYMBOL = m_stock->SYMBOL;
-                ndata->DATE = date_str;
-                ndata->VALUE = dPrice;
-                ndata->UPDTYPE = Model_StockHistory::ONLINE;
-                Model_StockHistory::instance().save(ndata);
-            }
+            Model_StockHistory::Data ndata;
+            ndata.SYMBOL = m_stock->SYMBOL;
+            ndata.DATE = date_str;
+            ndata.VALUE = dPrice;
+            ndata.UPDTYPE = Model_StockHistory::ONLINE;
+            prices.push_back(ndata);
         }
-        Model_StockHistory::instance().ReleaseSavepoint();
+        // prices already in the history are kept
+        Model_StockHistory::instance().addUpdate(prices, false);
         return ShowStockHistory();
     }
     mmErrorDialogs::MessageError(this, sOutput, _("Stock History Error"));
@@ -22,6 +22,7 @@
 #include "images_list.h"
 #include "mmSimpleDialogs.h"
 #include "mmTips.h"
+#include "quotes.h"
 #include "stockdialog.h"
 #include "sharetransactiondialog.h"
 
@@ -308,6 +309,7 @@ void mmStocksPanel::OnOpenAttachment(wxCommandEvent& event)
 
 void mmStocksPanel::OnRefreshQuotes(wxCommandEvent& WXUNUSED(event))
 {
+    mmQuoteService::instance().ClearCache();
     wxString sError = "";
     bool ok = onlineQuoteRefresh(sError);
     if (ok)
@@ -57,17 +57,9 @@ transactionsUpdateDialog::transactionsUpdateDialog(wxWindow* parent
     m_currency = Model_Currency::GetBaseCurrency(); // base currency if we need it
 
     // Determine the mix of transaction that have been selected
-    for (const auto& id : m_transaction_id)
+    for (const auto& trx : Model_Checking::instance().find_in(Model_Checking::TRANSID::name(), m_transaction_id))
     {
-        Model_Checking::Data *trx = Model_Checking::instance().get(id);
-        const bool isTransfer = Model_Checking::is_transfer(trx);
-
-        if (!m_hasSplits)
-        {
-            Model_Splittransaction::Data_Set split = Model_Splittransaction::instance().find(Model_Splittransaction::TRANSID(id));
-            if (!split.empty())
-                m_hasSplits = true;
-        }
+        const bool isTransfer = Model_Checking::is_transfer(&trx);
 
         if (!m_hasTransfers && isTransfer)
             m_hasTransfers = true;
@@ -75,6 +67,7 @@ transactionsUpdateDialog::transactionsUpdateDialog(wxWindow* parent
         if (!m_hasNonTransfers && !isTransfer)
             m_hasNonTransfers = true;
     }
+    m_hasSplits = !Model_Splittransaction::instance().find_in(Model_Splittransaction::TRANSID::name(), m_transaction_id).empty();
 
     m_custom_fields = new mmCustomDataTransaction(this, NULL, ID_CUSTOMFIELDS);
 
@@ -346,114 +339,51 @@ void transactionsUpdateDialog::OnOk(wxCommandEvent& WXUNUSED(event))
     }
     int categ_id = cbCategory_->mmGetCategoryId();
 
-    const auto split = Model_Splittransaction::instance().get_all();
-
-    std::vector<int> skip_trx;
-    Model_Checking::instance().Savepoint();
-    for (const auto& id : m_transaction_id)
-    {
-        Model_Checking::Data *trx = Model_Checking::instance().get(id);
-        bool is_locked = Model_Checking::is_locked(trx);
-
-        if (is_locked) {
-            skip_trx.push_back(trx->TRANSID);
-            continue;
-        }
-
-        if (m_status_checkbox->IsChecked()) {
-            trx->STATUS = status;
-        }
-
-        if (m_payee_checkbox->IsChecked()) {
-            trx->PAYEEID = payee_id;
-            trx->TOACCOUNTID = -1;
-        }
-
-        if (m_transferAcc_checkbox->IsChecked()) {
-            trx->TOACCOUNTID = cbAccount_->mmGetId();
-            trx->PAYEEID = -1;
-        }
-
-        if (m_date_checkbox->IsChecked()) {
-            wxString date = m_dpc->GetValue().FormatISODate();
-            const Model_Account::Data* account = Model_Account::instance().get(trx->ACCOUNTID);
-            const Model_Account::Data* to_account = Model_Account::instance().get(trx->TOACCOUNTID);
-            if ((date < account->INITIALDATE) ||
-                (to_account && (date < to_account->INITIALDATE)))
-            {
-                skip_trx.push_back(trx->TRANSID);
-                continue;
-            }
-            trx->TRANSDATE = date;
+    Model_Checking::Bulk_Edit edit;
+    edit.status = m_status_checkbox->IsChecked();
+    edit.STATUS = status;
+    edit.type = m_type_checkbox->IsChecked();
+    edit.TRANSCODE = type;
+    edit.amount = m_amount_checkbox->IsChecked();
+    edit.TRANSAMOUNT = amount;
+    edit.payee = m_payee_checkbox->IsChecked();
+    edit.PAYEEID = payee_id;
+    edit.to_account = m_transferAcc_checkbox->IsChecked();
+    edit.TOACCOUNTID = cbAccount_->mmGetId();
+    edit.date = m_date_checkbox->IsChecked();
+    edit.TRANSDATE = m_dpc->GetValue().FormatISODate();
+    edit.category = m_categ_checkbox->IsChecked();
+    edit.CATEGID = categ_id;
+    edit.notes = m_notes_checkbox->IsChecked();
+    edit.append_notes = m_append_checkbox->IsChecked();
+    edit.NOTES = m_notes_ctrl->GetValue();
+
+    if (m_color_checkbox->IsChecked()) {
+        int color_id = bColours_->GetColorId();
+        if (color_id < 0 || color_id > 7) {
+            return mmErrorDialogs::ToolTip4Object(bColours_, _("Color"), _("Invalid value"), wxICON_ERROR);
         }
-
-        if (m_color_checkbox->IsChecked()) {
-            int color_id = bColours_->GetColorId();
-            if (color_id < 0 || color_id > 7) {
-                return mmErrorDialogs::ToolTip4Object(bColours_, _("Color"), _("Invalid value"), wxICON_ERROR);
-            }
-            trx->FOLLOWUPID = color_id == 0 ? -1 : color_id ; 
-        }
-
-        if (m_notes_checkbox->IsChecked()) {
-            if (m_append_checkbox->IsChecked()) {
-                trx->NOTES += (trx->NOTES.Right(1) == "\n" || trx->NOTES.empty()
-                    ? "" : "\n")
-                    + m_notes_ctrl->GetValue();
-            }
-            else {
-                trx->NOTES = m_notes_ctrl->GetValue();
-            }
-        }
-
-        if (m_amount_checkbox->IsChecked()) {
-            trx->TRANSAMOUNT = amount;
-        }
-
-        if (m_categ_checkbox->IsChecked()) {
-            trx->CATEGID = categ_id;
-        }
-
-        if (m_type_checkbox->IsChecked()) {
-            trx->TRANSCODE = type;
-        }
-
-        // Need to consider TOTRANSAMOUNT if material transaction change
-        if (m_amount_checkbox->IsChecked() || m_type_checkbox->IsChecked() || m_transferAcc_checkbox->IsChecked())
-        {
-            if (!Model_Checking::is_transfer(trx))
-            {
-                trx->TOTRANSAMOUNT = trx->TRANSAMOUNT;
-            } else
-            {
-                const auto acc = Model_Account::instance().get(trx->ACCOUNTID);
-                const auto curr = Model_Currency::instance().get(acc->CURRENCYID);
-                const auto to_acc = Model_Account::instance().get(trx->TOACCOUNTID);
-                const auto to_curr = Model_Currency::instance().get(to_acc->CURRENCYID);
-                if (curr == to_curr)
-                {
-                    trx->TOTRANSAMOUNT = trx->TRANSAMOUNT;
-                } else
-                {
-                    double exch = 1;
-                    const double convRateTo = Model_CurrencyHistory::getDayRate(to_curr->CURRENCYID, trx->TRANSDATE);
-                    if (convRateTo > 0)
-                    {
-                        const double convRate = Model_CurrencyHistory::getDayRate(curr->CURRENCYID, trx->TRANSDATE);
-                        exch = convRate / convRateTo;
-                    }
-                    trx->TOTRANSAMOUNT = trx->TRANSAMOUNT * exch;
-                }
-            }
-        }
-
-        m_custom_fields->UpdateCustomValues(id);
-
-        Model_Checking::instance().save(trx);
+        edit.color = true;
+        edit.FOLLOWUPID = color_id == 0 ? -1 : color_id;
     }
-    Model_Checking::instance().ReleaseSavepoint();
 
-    skip_trx; //TODO: resume
+    // locked transactions and dates before the account opening are left unchanged
+    std::vector<int> updated;
+    Model_Checking::instance().Savepoint("MMEX_Update");
+    try
+    {
+        updated = Model_Checking::instance().update(m_transaction_id, edit);
+        m_custom_fields->UpdateCustomValues(updated);
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        Model_Checking::instance().Rollback("MMEX_Update");
+        Model_Checking::instance().ReleaseSavepoint("MMEX_Update");
+        Model_Checking::instance().refresh_cache(updated);
+        wxLogError("%s", e.GetMessage());
+        return;
+    }
+    Model_Checking::instance().ReleaseSavepoint("MMEX_Update");
 
     EndModal(wxID_OK);
 }
@@ -31,6 +31,7 @@
 #include "platfdep.h"
 #include "paths.h"
 #include "validators.h"
+#include "quotes.h"
 #include "model/Model_Currency.h"
 #include "model/Model_Infotable.h"
 #include "model/Model_Setting.h"
@@ -666,6 +667,8 @@ END_EVENT_TABLE()
 
 //--------------------------------------------------------------------
 
+static bool parseCoincapSearch(const wxString& symbol, const wxString& json_data, wxString& out_id, double& price_usd, wxString& output);
+
 bool getOnlineCurrencyRates(wxString& msg, int curr_id, bool used_only)
 {
     wxString base_currency_symbol;
@@ -705,25 +708,32 @@ bool getOnlineCurrencyRates(wxString& msg, int curr_id, bool used_only)
 
     get_yahoo_prices(fiat, currency_data, base_currency_symbol, output, yahoo_price_type::FIAT);
 
-    // fallback to coincap if some currencies were not found
-    double usd_conv_rate = -1;
+    // fallback to coincap if some currencies were not found, all of them searched at once
+    std::vector<wxString> coincap_symbols, coincap_urls;
     for (const auto & item : fiat)
     {
         if (currency_data.find(item.first) == currency_data.end() && !g_fiat_curr().Contains(item.first))
+        {
+            coincap_symbols.push_back(item.first);
+            coincap_urls.push_back(wxString::Format(mmex::weblink::CoinCapSearch, item.first));
+        }
+    }
+
+    // can't use coincap without USD, since all prices are in USD
+    auto usd = coincap_symbols.empty() ? nullptr : Model_Currency::instance().GetCurrencyRecord("USD");
+    if (usd)
+    {
+        const auto responses = mmQuoteService::instance().get(coincap_urls);
+        for (size_t i = 0; i < coincap_symbols.size(); i++)
         {
             wxString coincap_id;
             wxString coincap_msg;
             double coincap_price_usd;
-            if (getCoincapInfoFromSymbol(item.first, coincap_id, coincap_price_usd, coincap_msg) && coincap_price_usd > 0) {
-                if (usd_conv_rate < 0) {
-                    auto usd = Model_Currency::instance().GetCurrencyRecord("USD");
-                    if (usd == nullptr) {
-                        break; // can't use coincap without USD, since all prices are in USD so give up
-                    }
-                    usd_conv_rate = usd->BASECONVRATE;
-                }
-
-                currency_data[item.first] = coincap_price_usd * usd_conv_rate;
+            if (responses[i].code == CURLE_OK
+                && parseCoincapSearch(coincap_symbols[i], responses[i].output, coincap_id, coincap_price_usd, coincap_msg)
+                && coincap_price_usd > 0)
+            {
+                currency_data[coincap_symbols[i]] = coincap_price_usd * usd->BASECONVRATE;
             }
         }
     }
@@ -819,7 +829,7 @@ bool get_yahoo_prices(std::map<wxString, double>& symbols
     const auto URL = wxString::Format(mmex::weblink::YahooQuotes, buffer);
 
     wxString json_data;
-    auto err_code = http_get_data(URL, json_data);
+    auto err_code = mmQuoteService::instance().get(URL, json_data);
     if (err_code != CURLE_OK)
     {
         output = json_data;
@@ -935,13 +945,18 @@ bool getCoincapInfoFromSymbol(const wxString symbol, wxString& out_id, double& p
     wxString url = wxString::Format(mmex::weblink::CoinCapSearch, symbol);
 
     wxString json_data;
-    auto err_code = http_get_data(url, json_data);
+    auto err_code = mmQuoteService::instance().get(url, json_data);
     if (err_code != CURLE_OK)
     {
         output = json_data;
         return false;
     }
 
+    return parseCoincapSearch(symbol, json_data, out_id, price_usd, output);
+}
+
+// reads the response of a coincap search for the symbol
+static bool parseCoincapSearch(const wxString& symbol, const wxString& json_data, wxString& out_id, double& price_usd, wxString& output) {
     Document json_doc;
     if (json_doc.Parse(json_data.utf8_str()).HasParseError()) {
         output = _("JSON Parse Error");
@@ -994,7 +1009,7 @@ bool getCoincapAssetHistory(const wxString asset_id, wxDateTime begin_date, std:
     wxString url = wxString::Format(mmex::weblink::CoinCapHistory, asset_id, "d1", begin_date_unix, end_date_unix);
 
     wxString json_data;
-    auto err_code = http_get_data(url, json_data);
+    auto err_code = mmQuoteService::instance().get(url, json_data);
     if (err_code != CURLE_OK)
     {
         msg = json_data;
@@ -1142,7 +1157,7 @@ static int log_libcurl_debug(CURL *handle, curl_infotype type, char *data, size_
 }
 #endif
 
-void curl_set_common_options(CURL* curl, const wxString& useragent = wxEmptyString) {
+void curl_set_common_options(CURL* curl, const wxString& useragent) {
     wxString proxyName = Model_Setting::instance().GetStringSetting("PROXYIP", "");
     if (!proxyName.IsEmpty())
     {
@@ -195,6 +195,7 @@ extern const std::map<int, std::pair<wxConvAuto, wxString> > g_encoding;
 inline const wxString mmGetMonthName(wxDateTime::Month month) { return MONTHS[static_cast<int>(month)]; }
 //----------------------------------------------------------------------------
 
+void curl_set_common_options(CURL* curl, const wxString& useragent = wxEmptyString);
 CURLcode http_get_data(const wxString& site, wxString& output, const wxString& useragent = wxEmptyString);
 CURLcode http_post_data(const wxString& site, const wxString& data, const wxString& contentType, wxString& output);
 CURLcode http_download_file(const wxString& site, const wxString& path);
@@ -100,6 +100,35 @@ base_data_types_reverse = {
     'DATE': 'wxDateTime',
 }
 
+# Natural keys looked up through get_one(). Each gets a hash index kept
+# alongside index_by_id_, so get_one() on exactly these columns does not
+# scan the memory table.
+unique_keys = {
+    'ACCOUNTLIST_V1': [['ACCOUNTNAME']],
+    'CURRENCYHISTORY_V1': [['CURRENCYID', 'CURRDATE']],
+    'PAYEE_V1': [['PAYEENAME']],
+    'STOCKHISTORY_V1': [['SYMBOL', 'DATE']],
+}
+
+# Columns holding ISO 8601 "YYYY-MM-DD" dates. Data gains a <COLUMN>_date()
+# accessor returning the column as an mmDate, for comparisons without parsing
+# the string through wxDateTime.
+iso_dates = {
+    'ACCOUNTLIST_V1': ['INITIALDATE', 'STATEMENTDATE', 'PAYMENTDUEDATE'],
+    'ASSETS_V1': ['STARTDATE'],
+    'BILLSDEPOSITS_V1': ['TRANSDATE', 'NEXTOCCURRENCEDATE'],
+    'CHECKINGACCOUNT_V1': ['TRANSDATE'],
+    'CURRENCYHISTORY_V1': ['CURRDATE'],
+    'STOCK_V1': ['PURCHASEDATE'],
+    'STOCKHISTORY_V1': ['DATE'],
+    'USAGE_V1': ['USAGEDATE'],
+}
+
+# Large tables whose query results can be read as a compact DB_View: the
+# table gains a Row with the strings in a DB_String_Pool, pack() reading a
+# Row straight from the result set, and all_view() next to all().
+arena_tables = ['CHECKINGACCOUNT_V1']
+
 base_data_types_function = {
     'TEXT': 'GetString',
     'NUMERIC': 'GetDouble',
@@ -115,6 +144,160 @@ class DB_Table:
         self._primay_key = [field['name'] for field in self._fields if field['pk']][0]
         self._index = index
         self._data = data
+        self._keys = unique_keys.get(table.upper(), [])
+        self._dates = iso_dates.get(table.upper(), [])
+        self._arena = table.upper() in arena_tables
+
+    def key_name(self, key):
+        return '_'.join(key)
+
+    def key_field_type(self, name):
+        return [base_data_types_reverse[field['type']] for field in self._fields if field['name'] == name][0]
+
+    def generate_key_members(self):
+        """Declarations of the natural key indexes, mapping a key to the record id"""
+        if not self._keys:
+            return ''
+        s = '''
+    typedef std::unordered_map<std::wstring, int> Index_By_Key;'''
+        for key in self._keys:
+            s += '''
+    Index_By_Key index_by_%s_;''' % self.key_name(key)
+        return s
+
+    def generate_key_clear(self):
+        return ''.join(['''
+        index_by_%s_.clear();''' % self.key_name(key) for key in self._keys])
+
+    def generate_key_update(self, entity, indent):
+        """Statement adding a cached record to the natural key indexes"""
+        if not self._keys:
+            return ''
+        return '''
+%sindex_keys(%s);''' % (' ' * indent, entity)
+
+    def generate_key_save(self):
+        """In-place update of a cached record in save(), re-indexing it when the table has natural keys"""
+        if not self._keys:
+            return '''
+                        *e = *entity;  // in-place update'''
+        return '''
+                    {
+                        *e = *entity;  // in-place update
+                        index_keys(e);
+                    }'''
+
+    def generate_key_index(self):
+        """Key functions, index maintenance and get_one() overloads for the natural keys"""
+        if not self._keys:
+            return ''
+        blocks = []
+        for key in self._keys:
+            params = ', '.join(['%s arg%d' % ('const wxString&' if self.key_field_type(name) == 'wxString' else self.key_field_type(name), i + 1)
+                for i, name in enumerate(key)])
+            parts = ' + L"\\t" + '.join([('arg%d.Lower().ToStdWstring()' if self.key_field_type(name) == 'wxString' else 'std::to_wstring(arg%d)') % (i + 1)
+                for i, name in enumerate(key)])
+            blocks.append('''    /** Key of %s in index_by_%s_, case-insensitive like match() */
+    static std::wstring key_%s(%s)
+    {
+        return %s;
+    }''' % (', '.join(key), self.key_name(key), self.key_name(key), params, parts))
+
+        blocks.append('''    /** Add the cached record to the natural key indexes */
+    void index_keys(const Self::Data* entity)
+    {%s
+    }''' % ''.join(['''
+        index_by_%s_[key_%s(%s)] = entity->id();''' % (self.key_name(key), self.key_name(key), ', '.join(['entity->' + name for name in key]))
+            for key in self._keys]))
+
+        for key in self._keys:
+            params = ', '.join(['const Self::%s& arg%d' % (name, i + 1) for i, name in enumerate(key)])
+            args = ', '.join(['arg%d' % (i + 1) for i in range(len(key))])
+            blocks.append('''    /** Return the cached record with the given %s through the index, without scanning the cache */
+    Self::Data* get_one(%s)
+    {
+        Index_By_Key::iterator it = index_by_%s_.find(key_%s(%s));
+        if (it != index_by_%s_.end())
+        {
+            Index_By_Id::iterator entity = index_by_id_.find(it->second);
+            if (entity != index_by_id_.end() && match(entity->second, %s))
+            {
+                ++ hit_;
+                return entity->second;
+            }
+            index_by_%s_.erase(it); // the record was removed or its key changed
+        }
+
+        ++ miss_;
+
+        return 0;
+    }''' % (', '.join(key), params, self.key_name(key), self.key_name(key), ', '.join(['arg%d.v_' % (i + 1) for i in range(len(key))]),
+                self.key_name(key), args, self.key_name(key)))
+
+        return ''.join(['\n\n' + block for block in blocks])
+
+    def generate_row(self):
+        """Row and pack() for the tables read through DB_View"""
+        if not self._arena:
+            return ''
+        types = [(field['name'], base_data_types_reverse[field['type']]) for field in self._fields]
+        # doubles first so the row has no padding
+        members = [(name, t) for name, t in types if t == 'double'] + [(name, t) for name, t in types if t == 'int'] \
+            + [(name, t) for name, t in types if t == 'wxString']
+        s = '''
+    /** Data packed into a DB_View: numbers in place, strings in the view's DB_String_Pool */
+    struct Row
+    {'''
+        for name, t in members:
+            s += '''
+        %s %s;''' % ('DB_Str' if t == 'wxString' else t, name)
+        s += '''
+    };
+
+    /** Read the current row of a result set over query() without building a Data */
+    static Row pack(wxSQLite3ResultSet& q, DB_String_Pool& pool)
+    {
+        Row r;'''
+        for name, t in members:
+            index = [field['name'] for field in self._fields].index(name)
+            getter = base_data_types_function[self._fields[index]['type']]
+            s += ('''
+        r.%s = pool.intern(q.%s(%d)); // %s''' if t == 'wxString' else '''
+        r.%s = q.%s(%d); // %s''') % (name, getter, index, name)
+        s += '''
+        return r;
+    }
+
+    typedef DB_View<Self> View;
+'''
+        return s
+
+    def generate_all_view(self):
+        """all() returning a DB_View for the tables with a Row"""
+        if not self._arena:
+            return ''
+        return '''
+    /**
+    * Return the records as a compact View derived directly from the database,
+    * sorted like all().
+    */
+    const View all_view(wxSQLite3Database* db, COLUMN col = COLUMN(0), bool asc = true)
+    {
+        try
+        {
+            wxSQLite3ResultSet q = db->ExecuteQuery(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "));
+            const View result(q);
+            q.Finalize();
+            return result;
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("%s: Exception %s", this->name().utf8_str(), e.GetMessage().utf8_str());
+        }
+
+        return View();
+    }
+'''
 
     def generate_currency_table_data(self, sf1, utf_only):
         """Extract currency table data from table_v1
@@ -200,7 +383,7 @@ struct DB_Table_%s : public DB_Table
     typedef std::vector<Self::Data*> Cache;
     typedef std::map<int, Self::Data*> Index_By_Id;
     Cache cache_;
-    Index_By_Id index_by_id_;
+    Index_By_Id index_by_id_;%s
     Data* fake_; // in case the entity not found
 
     /** Destructor: clears any data records stored in memory */
@@ -215,9 +398,9 @@ struct DB_Table_%s : public DB_Table
     {
         std::for_each(cache_.begin(), cache_.end(), std::mem_fn(&Data::destroy));
         cache_.clear();
-        index_by_id_.clear(); // no memory release since it just stores pointer and the according objects are in cache
+        index_by_id_.clear(); // no memory release since it just stores pointer and the according objects are in cache%s
     }
-''' % (self._table, self._table, self._table)
+''' % (self._table, self._table, self.generate_key_members(), self._table, self.generate_key_clear())
 
         s += '''
     /** Creates the database table if the table does not exist*/
@@ -387,6 +570,14 @@ struct DB_Table_%s : public DB_Table
         }
 ''' % (self._primay_key, self._primay_key)
 
+        for name in self._dates:
+            s += '''
+        mmDate %s_date() const
+        {
+            return mmDate::FromISO(%s);
+        }
+''' % (name, name)
+
         s += '''
         explicit Data(Self* table = 0) 
         {
@@ -549,6 +740,7 @@ struct DB_Table_%s : public DB_Table
         }
     };
 ''' % (self._table.upper(), self._table.upper())
+        s += self.generate_row()
         s += '''
     enum
     {
@@ -633,8 +825,7 @@ struct DB_Table_%s : public DB_Table
                 for(Cache::iterator it = cache_.begin(); it != cache_.end(); ++ it)
                 {
                     Self::Data* e = *it;
-                    if (e->id() == entity->id()) 
-                        *e = *entity;  // in-place update
+                    if (e->id() == entity->id()) %s
                 }
             }
         }
@@ -647,11 +838,11 @@ struct DB_Table_%s : public DB_Table
         if (entity->id() <= 0)
         {
             entity->id((db->GetLastRowId()).ToLong());
-            index_by_id_.insert(std::make_pair(entity->id(), entity));
+            index_by_id_.insert(std::make_pair(entity->id(), entity));%s
         }
         return true;
     }
-''' % (len(self._fields), self._primay_key, self._table)
+''' % (len(self._fields), self._primay_key, self.generate_key_save(), self._table, self.generate_key_update('entity', 12))
         s += '''
     /** Remove the Data record from the database and the memory table (cache) */
     bool remove(int id, wxSQLite3Database* db)
@@ -722,6 +913,7 @@ struct DB_Table_%s : public DB_Table
 
         return 0;
     }'''
+        s += self.generate_key_index()
 
         s += '''
     
@@ -757,7 +949,9 @@ struct DB_Table_%s : public DB_Table
             {
                 entity = new Self::Data(q, this);
                 cache_.push_back(entity);
-                index_by_id_.insert(std::make_pair(id, entity));
+                index_by_id_.insert(std::make_pair(id, entity));'''
+        s += self.generate_key_update('entity', 16)
+        s += '''
             }
             stmt.Finalize();
         }
@@ -803,6 +997,7 @@ struct DB_Table_%s : public DB_Table
         return result;
     }
 '''
+        s += self.generate_all_view()
         s += '''};
 
 '''
@@ -814,6 +1009,10 @@ def generate_base_class(header, fields=set):
 
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <memory>
+#include <string>
+#include <cstdint>
 #include <algorithm>
 #include <functional>
 #include <cwchar>
@@ -829,6 +1028,8 @@ using namespace rapidjson;
 #include "html_template.h"
 using namespace tmpl;
 
+#include "mmDate.h"
+
 class wxString;
 enum OP { EQUAL = 0, GREATER, LESS, GREATER_OR_EQUAL, LESS_OR_EQUAL, NOT_EQUAL };
 
@@ -952,6 +1153,136 @@ bool match(const DATA* data, const Arg1& arg1, const Args&... args)
     else
         return false; // Short-circuit evaluation
 }
+
+/**
+Locale case-insensitive sort key of a string: comparing two keys with <
+orders the strings as wcscoll() of their lower case forms does.
+*/
+inline std::wstring collation_key(const wxString& s)
+{
+    const std::wstring lower = s.Lower().ToStdWstring();
+    std::vector<wchar_t> key(std::wcsxfrm(nullptr, lower.c_str(), 0) + 1);
+    const size_t n = std::wcsxfrm(key.data(), lower.c_str(), key.size());
+    return std::wstring(key.data(), n);
+}
+
+/**
+Stable sort of the rows by the key() of a sorter, e.g. sort_by_key(payees, SorterByPAYEENAME()).
+The key is computed once per row instead of twice per comparison, and the
+rows are put in place once instead of being swapped around by the sort.
+*/
+template<class DATA, class SORTER>
+void sort_by_key(std::vector<DATA>& rows, const SORTER&)
+{
+    typedef decltype(SORTER::key(rows.front())) KEY;
+    std::vector<std::pair<KEY, size_t> > keys;
+    keys.reserve(rows.size());
+    for (size_t i = 0; i < rows.size(); i++)
+        keys.push_back(std::make_pair(SORTER::key(rows[i]), i));
+    std::stable_sort(keys.begin(), keys.end()
+        , [](const std::pair<KEY, size_t>& x, const std::pair<KEY, size_t>& y) { return x.first < y.first; });
+
+    std::vector<DATA> sorted;
+    sorted.reserve(rows.size());
+    for (const auto& k : keys)
+        sorted.push_back(rows[k.second]);
+    rows.swap(sorted);
+}
+
+struct DB_Str
+{
+    uint32_t offset, length;
+};
+
+/**
+UTF-8 storage for the strings of DB_View rows, one char buffer for all of them.
+Short strings repeat a lot (dates, codes, statuses, symbols) and are stored once.
+*/
+class DB_String_Pool
+{
+public:
+    DB_Str intern(const wxString& s)
+    {
+        const wxScopedCharBuffer utf8 = s.utf8_str();
+        const std::string str(utf8.data(), utf8.length());
+        if (str.size() > INTERN_MAX) return append(str);
+
+        const auto it = index_.find(str);
+        if (it != index_.end()) return it->second;
+        const DB_Str r = append(str);
+        index_.insert(std::make_pair(str, r));
+        return r;
+    }
+
+    wxString get(const DB_Str& s) const
+    {
+        return s.length ? wxString::FromUTF8(chars_.data() + s.offset, s.length) : wxString();
+    }
+
+    /** Release the intern index and the spare capacity once no more strings are added */
+    void freeze()
+    {
+        std::unordered_map<std::string, DB_Str>().swap(index_);
+        chars_.shrink_to_fit();
+    }
+
+    size_t size() const { return chars_.size(); }
+
+private:
+    static const size_t INTERN_MAX = 32;
+
+    DB_Str append(const std::string& s)
+    {
+        const DB_Str r = { static_cast<uint32_t>(chars_.size()), static_cast<uint32_t>(s.size()) };
+        chars_.insert(chars_.end(), s.begin(), s.end());
+        return r;
+    }
+
+    std::vector<char> chars_;
+    std::unordered_map<std::string, DB_Str> index_;
+};
+
+/**
+A read-only query result of a large table kept compact: each row of the
+result set is read into a TABLE::Row, numbers in place and strings in a
+DB_String_Pool, without building a TABLE::Data. Copies share the storage.
+Loops read rows() directly, with str() for the string columns.
+*/
+template<class TABLE>
+class DB_View
+{
+public:
+    typedef typename TABLE::Row Row;
+
+    DB_View(): arena_(std::make_shared<Arena>()) {}
+
+    /** Pack the remaining rows of the result set */
+    explicit DB_View(wxSQLite3ResultSet& q)
+    {
+        std::shared_ptr<Arena> arena = std::make_shared<Arena>();
+        while (q.NextRow())
+            arena->rows.push_back(TABLE::pack(q, arena->pool));
+        arena->rows.shrink_to_fit();
+        arena->pool.freeze();
+        arena_ = arena;
+    }
+
+    size_t size() const { return arena_->rows.size(); }
+    bool empty() const { return arena_->rows.empty(); }
+
+    const std::vector<Row>& rows() const { return arena_->rows; }
+    /** A string column of one of the rows */
+    wxString str(const DB_Str& s) const { return arena_->pool.get(s); }
+
+private:
+    struct Arena
+    {
+        std::vector<Row> rows;
+        DB_String_Pool pool;
+    };
+
+    std::shared_ptr<const Arena> arena_;
+};
 '''
     for field in sorted(fields):
         if field == 'ACCOUNTNAME' or field == 'CATEGNAME' or field == 'PAYEENAME' or field == 'SUBCATEGNAME':
@@ -963,8 +1294,29 @@ struct SorterBy%s
     {
         return (std::wcscoll(x.%s.Lower().wc_str(),y.%s.Lower().wc_str()) < 0);  // Locale case-insensitive
     }
+    template<class DATA>
+    static std::wstring key(const DATA& x)
+    {
+        return collation_key(x.%s);
+    }
+};
+''' % ( field, field, field, field)
+        elif field == 'NOTES':
+            code += '''
+struct SorterBy%s
+{ 
+    template<class DATA>
+    bool operator()(const DATA& x, const DATA& y)
+    {
+        return (x.%s) < (y.%s);
+    }
+    template<class DATA>
+    static std::wstring key(const DATA& x)
+    {
+        return x.%s.ToStdWstring();
+    }
 };
-''' % ( field, field, field)
+''' % ( field, field, field, field)
         else:
             transl = 'wxGetTranslation' if field == 'CURRENCYNAME' else ''
             code += '''